@@ -0,0 +1,18 @@
+#version 330 core
+layout (location = 0) out vec4 outFragColor;
+
+in vec4 vertexColor;
+in vec2 texCoord;
+
+uniform sampler2D uniformTexture0;
+
+// Averages the 2x2 source texels under the fragment, so small bright spots don't flicker in and out as they move.
+void main()
+{
+    vec2 tex_offset = 0.5 / textureSize(uniformTexture0, 0);
+    vec3 result = texture(uniformTexture0, texCoord + vec2(-tex_offset.x, -tex_offset.y)).rgb;
+    result += texture(uniformTexture0, texCoord + vec2(tex_offset.x, -tex_offset.y)).rgb;
+    result += texture(uniformTexture0, texCoord + vec2(-tex_offset.x, tex_offset.y)).rgb;
+    result += texture(uniformTexture0, texCoord + vec2(tex_offset.x, tex_offset.y)).rgb;
+    outFragColor = vec4(result * 0.25, 1.0);
+}
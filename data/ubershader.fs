@@ -9,43 +9,49 @@ in vec4 viewSpacePosition;
 uniform sampler2D uniformTexture0;
 uniform sampler2D uniformTexture1;
 
-uniform bool uniformEnableParticleMode;
-uniform bool uniformEnableEmission;
-uniform bool uniformEnableFog;
-uniform float uniformFogDensity;
+layout(std140) uniform PassConstants
+{
+    mat4 uniformView;
+    mat4 uniformProjection;
+    vec2 uniformResolution;
+    float uniformFogDensity;
+    int uniformLightCount;
+    vec4 uniformLightPositions[32];
+    vec4 uniformLightColors[32];
+};
 
 void main()
 {
-    vec2 final_texCoord;
-    if(uniformEnableParticleMode)
-        final_texCoord = gl_PointCoord;
-    else
-        final_texCoord = texCoord;
+#ifdef PARTICLE_MODE
+    vec2 final_texCoord = gl_PointCoord;
+#else
+    vec2 final_texCoord = texCoord;
+#endif
 
 	vec4 textureColor = texture(uniformTexture0, final_texCoord);
     if (textureColor.a <= 0.1)
         discard;
 
-    if(uniformEnableParticleMode && vertexColor.a <= 0.1)
+#ifdef PARTICLE_MODE
+    if(vertexColor.a <= 0.1)
         discard;
+#endif
 
     outFragColor = vertexColor * textureColor;
 
-    if(uniformEnableEmission)
-    {
-        vec4 emissionColor = texture(uniformTexture1, final_texCoord);
-        if(length(emissionColor.rgb) > 0)
-            outFragColor += textureColor * emissionColor;
-    }
-
-    if(uniformEnableFog)
-    {
-        float distance = length(viewSpacePosition);
-        float fogFactor = 1.0 /exp(distance * uniformFogDensity * distance * uniformFogDensity);
-        fogFactor = clamp( fogFactor, 0.0, 1.0 );
-
-        outFragColor.rgb *= fogFactor;
-    }
+#ifdef EMISSION
+    vec4 emissionColor = texture(uniformTexture1, final_texCoord);
+    if(length(emissionColor.rgb) > 0)
+        outFragColor += textureColor * emissionColor;
+#endif
+
+#ifdef FOG
+    float distance = length(viewSpacePosition);
+    float fogFactor = 1.0 /exp(distance * uniformFogDensity * distance * uniformFogDensity);
+    fogFactor = clamp( fogFactor, 0.0, 1.0 );
+
+    outFragColor.rgb *= fogFactor;
+#endif
 
     float brightness = dot(outFragColor.rgb, vec3(0.2126, 0.7152, 0.0722)) * outFragColor.a;
     outBrightFragColor = brightness > 0.75 ? vec4(outFragColor.rgb, outFragColor.a) : vec4(0.0, 0.0, 0.0, outFragColor.a);
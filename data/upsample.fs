@@ -0,0 +1,16 @@
+#version 330 core
+layout (location = 0) out vec4 outFragColor;
+
+in vec4 vertexColor;
+in vec2 texCoord;
+
+uniform sampler2D uniformTexture0;
+uniform sampler2D uniformTexture1;
+
+// Adds the coarser level onto the finer one. Halving the sum keeps the bloom about as bright as a single level.
+void main()
+{
+    vec3 fineColor = texture(uniformTexture0, texCoord).rgb;
+    vec3 coarseColor = texture(uniformTexture1, texCoord).rgb;
+    outFragColor = vec4((fineColor + coarseColor) * 0.5, 1.0);
+}
@@ -10,7 +10,9 @@ namespace mau {
 class sdl_context_t : non_copyable_t, non_movable_t
 {
 public:
-    explicit sdl_context_t();
+    // Headless contexts use SDL's offscreen video and dummy audio drivers, so neither a display nor a sound device is
+    // needed.
+    explicit sdl_context_t(bool headless = false);
     ~sdl_context_t();
 };
 
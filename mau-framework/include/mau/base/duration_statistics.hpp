@@ -0,0 +1,23 @@
+#pragma once
+
+#include "mau/base/types.hpp"
+
+#include <vector>
+
+namespace mau {
+
+// Summary of a series of durations, in seconds.
+struct duration_statistics_t
+{
+    size_t count{0};
+    double total{0.0};
+    double average{0.0};
+    double median{0.0};
+    double percentile_99{0.0};
+    double maximum{0.0};
+};
+
+// Summarizes durations given in microseconds. Sorts them in place.
+duration_statistics_t duration_statistics(std::vector<uint64_t>& microseconds);
+
+} // namespace mau
@@ -3,12 +3,17 @@
 #include "mau/SDL/SDL.hpp"
 #include "mau/audio/audio.hpp"
 #include "mau/base/configuration.hpp"
+#include "mau/base/engine_options.hpp"
+#include "mau/base/frame_pacer.hpp"
 #include "mau/base/log.hpp"
 #include "mau/base/state_manager.hpp"
 #include "mau/base/timer.hpp"
 #include "mau/logging/log_file.hpp"
 #include "mau/logging/log_stdout.hpp"
+#include "mau/profiling/profiler.hpp"
+#include "mau/rendering/program_cache.hpp"
 #include "mau/rendering/renderer.hpp"
+#include "mau/threading/job_system.hpp"
 
 #include <array>
 #include <memory>
@@ -22,8 +27,8 @@ class resource_cache_t;
 class engine_context_t : non_movable_t, non_copyable_t
 {
 public:
-    // Create the engine instance with specified name and log.
-    explicit engine_context_t(const char* name, log_t& log);
+    // Create the engine instance with specified name, log and options.
+    explicit engine_context_t(const char* name, log_t& log, const engine_options_t& options = {});
     ~engine_context_t();
 
     // Return references to various modules.
@@ -33,6 +38,13 @@ public:
     audio_t&          audio();
     state_manager_t&  state_manager();
     resource_cache_t& resource_cache();
+    job_system_t&     jobs();
+    frame_pacer_t&    frame_pacer();
+    profiler_t&       profiler();
+    program_cache_t&  program_cache();
+
+    // Options given on the command line.
+    const engine_options_t& options() const;
 
     // Returns drawable area size. This is scaled to fill the screen with aspect ratio correction.
     glm::ivec2 viewport_size() const;
@@ -46,7 +58,7 @@ public:
     // Returns difference in mouse position since last frame.
     glm::vec2 mouse_motion() const;
 
-    // Returns average framerate.
+    // Returns average framerate over the latest frames.
     double    framerate() const;
 
     // Returns SDL window handle.
@@ -71,8 +83,12 @@ public:
 private:
     void runImpl();
 
-    config_t config_m;
-    log_t&   log_m;
+    // Runs from the engine's creation, for timing how long the first frame takes to come up.
+    timer_t startup_timer_m;
+
+    config_t         config_m;
+    engine_options_t options_m;
+    log_t&           log_m;
 
     glm::ivec2 resolution_m;
 
@@ -80,16 +96,22 @@ private:
     sdl_mixer_context_t                                       sdl_mixer_context_m;
     std::unique_ptr<SDL_Window, decltype(&SDL_DestroyWindow)> sdl_window_m;
 
+    // Outlives the modules, which may record zones until they're gone.
+    profiler_t profiler_m;
+
+    // Outlives the shaders, which hold on to it for compiling variants.
+    program_cache_t program_cache_m;
+
     std::unique_ptr<resource_cache_t> resource_cache_m;
     std::unique_ptr<renderer_t>       renderer_m;
     std::unique_ptr<audio_t>          audio_m;
     std::unique_ptr<state_manager_t>  state_manager_m;
+    std::unique_ptr<job_system_t>     jobs_m;
 
     glm::vec2      mouse_motion_m;
     const uint8_t* sdl_keyboard_state_m;
 
-    std::array<double, 64> framerate_array_m = {0};
-    uint64_t               framerate_tick_m{0};
+    frame_pacer_t frame_pacer_m;
 
     bool restart_requested_m{false};
 };
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "mau/base/frame_pacer.hpp"
+#include "mau/base/types.hpp"
+
+#include <string>
+
+namespace mau {
+
+// Options for a single run of the engine, given on the command line. Unlike the configuration, these aren't saved.
+struct engine_options_t
+{
+    // Parses options, throwing on unknown or malformed ones. The first argument is the program name and is skipped.
+    static engine_options_t parse(int argc, const char* const* argv);
+
+    // Headless runs and timedemos have nobody at the controls, so they skip the menus and run as fast as they can.
+    bool unattended() const;
+
+    // Runs without a visible window and without sound, on an offscreen GL context. Meant for benchmarking on machines
+    // without a display.
+    bool headless{false};
+
+    // Number of frames after which the engine exits, zero to run until the game quits.
+    uint64_t frame_limit{0};
+
+    // Gameplay is recorded into this file if set.
+    std::string record_path;
+
+    // Plays back a recording as fast as possible and reports how long frames and ticks took, if set.
+    std::string timedemo_path;
+
+    // Zones are profiled from the start and saved into this file as a Chrome trace on exit, if set.
+    std::string profile_path;
+
+    // Linked shader programs are cached on disk, unless turned off to measure startup with a cold cache.
+    bool shader_cache{true};
+
+    // Tick rate, substep cap and frame rate limit the frame pacer starts with. Recordings don't store the tick rate,
+    // so they only play back the way they were recorded at the default one.
+    frame_pacer_settings_t frame_pacer;
+};
+
+} // namespace mau
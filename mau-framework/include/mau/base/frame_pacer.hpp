@@ -0,0 +1,96 @@
+#pragma once
+
+#include "mau/base/timer.hpp"
+#include "mau/base/types.hpp"
+
+#include <array>
+
+namespace mau {
+
+// Ways of holding frames back to the frame rate limit.
+enum class frame_limiter_t
+{
+    // Sleeps for most of the remaining time and spins through the rest, since sleeps tend to overshoot a little.
+    sleep_k,
+    // Spins all the way. Most precise, but keeps a core busy.
+    spin_k
+};
+
+struct frame_pacer_settings_t
+{
+    // Rate of fixed updates, in updates per second.
+    double fixed_rate{60.0};
+
+    // Most fixed updates run in a single frame. Time beyond is dropped, so a slow frame can't make the next one slower.
+    uint32_t max_substeps{5};
+
+    // Frames longer than this, in seconds, are hitches. Time lost to hitches is dropped entirely.
+    double hitch_threshold{0.25};
+
+    // Fixed updates run every frame no matter how much time passed, zero to follow real time. Recordings play back as
+    // fast as the engine can go this way, instead of at the rate they were recorded at.
+    uint32_t lockstep_steps{0};
+
+    // Frame rate limit in frames per second, zero for none. Only applied when asked to, i.e. when vsync is off.
+    double          frame_rate_limit{0.0};
+    frame_limiter_t limiter{frame_limiter_t::sleep_k};
+};
+
+// Frame times over the latest frames, in seconds.
+struct frame_statistics_t
+{
+    double average{0.0};
+    double minimum{0.0};
+    double maximum{0.0};
+    double percentile_99{0.0};
+
+    // Totals since the pacer was created.
+    uint64_t hitch_count{0};
+    uint64_t dropped_steps{0};
+};
+
+// Splits real time into fixed update steps. Time left over after the steps is kept for later frames, and the fraction of
+// a step it amounts to is exposed for interpolating between the last two fixed updates while rendering.
+class frame_pacer_t
+{
+public:
+    explicit frame_pacer_t(const frame_pacer_settings_t& settings = {});
+
+    // Starts a frame at the given time and returns the number of fixed updates to run during it.
+    uint32_t advance(uint64_t time_microseconds);
+
+    // Blocks until the frame rate limit allows the next frame to start. No-op if there's no limit.
+    void limit_frame_rate(const timer_t& timer) const;
+
+    // Forgets the accumulated time, e.g. after loading something big, so no fixed updates are run to catch up on it.
+    void reset();
+
+    float fixed_delta_time() const;
+    float frame_delta_time() const;
+
+    // Fraction of a fixed update accumulated past the latest one, in range [0, 1).
+    float alpha() const;
+
+    frame_statistics_t statistics() const;
+
+    const frame_pacer_settings_t& settings() const;
+    void                          set_settings(const frame_pacer_settings_t& settings);
+
+private:
+    frame_pacer_settings_t settings_m;
+
+    uint64_t fixed_step_microseconds_m{0};
+    uint64_t accumulator_m{0};
+    uint64_t frame_start_m{0};
+    uint64_t frame_delta_m{0};
+    bool     started_m{false};
+
+    // Ring of the latest frame times in microseconds, for statistics.
+    std::array<uint64_t, 128> frame_times_m{};
+    size_t                    frame_count_m{0};
+
+    uint64_t hitch_count_m{0};
+    uint64_t dropped_steps_m{0};
+};
+
+} // namespace mau
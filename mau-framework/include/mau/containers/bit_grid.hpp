@@ -0,0 +1,47 @@
+#pragma once
+
+#include "mau/base/types.hpp"
+#include "mau/math/vector.hpp"
+
+#include <vector>
+
+namespace mau {
+
+// Compact two-dimensional bitmap, one bit per cell with rows padded to whole 64-bit words. Cells outside the grid read
+// as set, so traversals treat the grid border as solid.
+class bit_grid_t
+{
+public:
+    bit_grid_t() = default;
+    explicit bit_grid_t(glm::ivec2 size);
+
+    glm::ivec2 size() const;
+    bool       contains(glm::ivec2 cell) const;
+
+    bool get(glm::ivec2 cell) const;
+    void set(glm::ivec2 cell, bool value);
+
+    // Raw row storage, for code which wants to test several cells at once.
+    const uint64_t* row(int32_t y) const;
+    size_t          words_per_row() const;
+
+private:
+    glm::ivec2            size_m{0, 0};
+    size_t                words_per_row_m{0};
+    std::vector<uint64_t> words_m;
+};
+
+inline bool bit_grid_t::contains(glm::ivec2 cell) const
+{
+    return cell.x >= 0 && cell.y >= 0 && cell.x < size_m.x && cell.y < size_m.y;
+}
+
+inline bool bit_grid_t::get(glm::ivec2 cell) const
+{
+    if(!contains(cell))
+        return true;
+
+    return (words_m[cell.y * words_per_row_m + (cell.x >> 6)] >> (cell.x & 63)) & 1;
+}
+
+} // namespace mau
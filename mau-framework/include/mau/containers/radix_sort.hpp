@@ -0,0 +1,21 @@
+#pragma once
+
+#include "mau/base/types.hpp"
+
+#include <vector>
+
+namespace mau {
+
+// Index of an item along with the key it's sorted by.
+struct radix_sort_entry_t
+{
+    uint64_t key;
+    uint32_t index;
+};
+
+// Sorts entries by key, a byte at a time from the least significant one. Entries with equal keys keep their order.
+// Bytes every key has in common are skipped, so keys with few bits in use cost few passes. The scratch list is resized
+// to match and left with no meaningful contents, and may be reused across sorts to avoid allocating.
+void radix_sort(std::vector<radix_sort_entry_t>& entries, std::vector<radix_sort_entry_t>& scratch);
+
+} // namespace mau
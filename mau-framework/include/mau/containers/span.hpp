@@ -19,6 +19,9 @@ public:
     const T* data() const;
     size_t   size() const;
 
+    const T* begin() const;
+    const T* end() const;
+
 private:
     const T*     data_m;
     const size_t size_m;
@@ -46,6 +49,18 @@ inline size_t span_t<T>::size() const
     return size_m;
 }
 
+template<typename T>
+inline const T* span_t<T>::begin() const
+{
+    return data_m;
+}
+
+template<typename T>
+inline const T* span_t<T>::end() const
+{
+    return data_m + size_m;
+}
+
 template<typename T>
 template<typename Container>
 inline span_t<T>::span_t(Container& container) : data_m(container.data()), size_m(container.size())
@@ -91,5 +91,82 @@ inline bool aabb_ray_intersect(const glm::vec3 aabb_position,
     return true;
 }
 
+// View wedge with its apex at the origin, centered around a direction and spanning half angle to either side. Keeps
+// the edges around, so testing many boxes against the same view doesn't repeat the trigonometry.
+struct view_wedge_t
+{
+    glm::vec2 origin{};
+    glm::vec2 left{};
+    glm::vec2 right{};
+};
+
+// Half angle must be below a right angle.
+inline view_wedge_t make_view_wedge(const glm::vec2 origin, const glm::vec2 direction, const float half_angle)
+{
+    const float cos_angle = std::cos(half_angle);
+    const float sin_angle = std::sin(half_angle);
+
+    // Edges of the wedge, direction rotated either way.
+    view_wedge_t wedge;
+    wedge.origin = origin;
+    wedge.left   = {direction.x * cos_angle - direction.y * sin_angle,
+                    direction.x * sin_angle + direction.y * cos_angle};
+    wedge.right  = {direction.x * cos_angle + direction.y * sin_angle,
+                    -direction.x * sin_angle + direction.y * cos_angle};
+    return wedge;
+}
+
+// Returns true if 2D axis-aligned box intersects the view wedge.
+inline bool aabb_view_wedge_intersect(const glm::vec2 box_min, const glm::vec2 box_max, const view_wedge_t& wedge)
+{
+    const glm::vec2 origin = wedge.origin;
+
+    if(origin.x >= box_min.x && origin.x <= box_max.x && origin.y >= box_min.y && origin.y <= box_max.y)
+        return true;
+
+    const glm::vec2 corners[] = {box_min - origin,
+                                 glm::vec2{box_max.x, box_min.y} - origin,
+                                 glm::vec2{box_min.x, box_max.y} - origin,
+                                 box_max - origin};
+
+    // The box is outside if all of its corners lie beyond the same edge of the wedge.
+    bool outside_left{true};
+    bool outside_right{true};
+
+    for(const auto& corner: corners)
+    {
+        if(corner.x * wedge.left.y - corner.y * wedge.left.x >= 0)
+            outside_left = false;
+        if(wedge.right.x * corner.y - wedge.right.y * corner.x >= 0)
+            outside_right = false;
+    }
+
+    if(outside_left || outside_right)
+        return false;
+
+    // The wedge edges and the box axes are all the separating axes there are. Along a box axis, the wedge only
+    // extends to one side of the origin if both of its edges point that way.
+    for(int32_t axis = 0; axis < 2; ++axis)
+    {
+        if(wedge.left[axis] >= 0 && wedge.right[axis] >= 0 && box_max[axis] < origin[axis])
+            return false;
+        if(wedge.left[axis] <= 0 && wedge.right[axis] <= 0 && box_min[axis] > origin[axis])
+            return false;
+    }
+
+    return true;
+}
+
+// Returns true if 2D axis-aligned box intersects the view wedge with its apex at the origin, centered around the
+// direction and spanning half angle to either side. Half angle must be below a right angle.
+inline bool aabb_view_wedge_intersect(const glm::vec2 box_min,
+                                      const glm::vec2 box_max,
+                                      const glm::vec2 origin,
+                                      const glm::vec2 direction,
+                                      const float     half_angle)
+{
+    return aabb_view_wedge_intersect(box_min, box_max, make_view_wedge(origin, direction, half_angle));
+}
+
 } // namespace math
 } // namespace mau
@@ -2,9 +2,14 @@
 
 #include "mau/base/types.hpp"
 
+#include <string_view>
+
 namespace mau
 {
     // Returns adler32 checksum of given data.
     // TODO: refactor to use mau::span
     uint32_t adler32(byte_t* data, size_t size);
+
+    // Returns 64-bit FNV-1a hash of given data. Hashes of several pieces are chained by passing the previous hash.
+    uint64_t fnv1a64(std::string_view data, uint64_t hash = 0xcbf29ce484222325ULL);
 }
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "mau/containers/bit_grid.hpp"
+
+#include <limits>
+#include <vector>
+
+namespace mau {
+
+// Shortest paths from every cell of a grid towards a single target cell, found by a breadth first search over open
+// cells. Every cell stores the neighbour to move to next, so any number of agents can look up their way in constant
+// time. Moves are 8-connected, but never cut corners of blocked cells.
+class flow_field_t
+{
+public:
+    inline static constexpr uint32_t unreachable_k = std::numeric_limits<uint32_t>::max();
+
+    flow_field_t() = default;
+    explicit flow_field_t(const bit_grid_t& blocked);
+
+    // Searches paths towards the target. Storage is reused, so it's cheap enough to redo whenever the target moves.
+    void compute(glm::ivec2 target);
+
+    glm::ivec2 target() const;
+
+    // Number of moves it takes from the cell to the target, or unreachable_k.
+    uint32_t distance(glm::ivec2 cell) const;
+
+    // Cell to move to next on the way to the target. Returns the cell itself at the target or when it's unreachable.
+    glm::ivec2 next_cell(glm::ivec2 cell) const;
+
+private:
+    const bit_grid_t* blocked_m{nullptr};
+    glm::ivec2        target_m{-1, -1};
+
+    // Per cell distance to the target and index of the move towards it, row by row.
+    std::vector<uint32_t> distances_m;
+    std::vector<uint8_t>  moves_m;
+
+    // Per cell bit mask of moves which don't lead into or past blocked cells.
+    std::vector<uint8_t> open_moves_m;
+
+    std::vector<glm::ivec2> frontier_m;
+};
+
+} // namespace mau
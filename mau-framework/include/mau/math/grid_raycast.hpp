@@ -0,0 +1,96 @@
+#pragma once
+
+#include "mau/containers/bit_grid.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace mau {
+namespace math {
+
+// Traversal state of a single ray, as the DDA steps it from cell to cell.
+struct grid_ray_t
+{
+    glm::ivec2 cell{};
+    glm::ivec2 step_direction{};
+    glm::vec2  delta_distance{};
+    glm::vec2  side_distance{};
+};
+
+// Sets up traversal starting at the cell containing the origin. Axes the direction doesn't move along never step.
+inline grid_ray_t make_grid_ray(glm::vec2 origin, glm::vec2 direction)
+{
+    static constexpr float infinity_k = std::numeric_limits<float>::infinity();
+
+    grid_ray_t ray;
+    ray.cell           = glm::ivec2{std::floor(origin.x), std::floor(origin.y)};
+    ray.delta_distance = glm::vec2{direction.x != 0 ? std::abs(1 / direction.x) : infinity_k,
+                                   direction.y != 0 ? std::abs(1 / direction.y) : infinity_k};
+
+    for(auto i = 0; i < 2; ++i)
+    {
+        if(direction[i] < 0)
+        {
+            ray.step_direction[i] = -1;
+            ray.side_distance[i]  = (origin[i] - ray.cell[i]) * ray.delta_distance[i];
+        }
+        else if(direction[i] > 0)
+        {
+            ray.step_direction[i] = 1;
+            ray.side_distance[i]  = (ray.cell[i] + 1.0f - origin[i]) * ray.delta_distance[i];
+        }
+        else
+        {
+            ray.step_direction[i] = 0;
+            ray.side_distance[i]  = infinity_k;
+        }
+    }
+
+    return ray;
+}
+
+// Upper bound on steps a ray needs to leave the grid. Keeps degenerate directions from looping forever.
+inline int32_t grid_raycast_max_steps(const bit_grid_t& grid)
+{
+    return grid.size().x + grid.size().y + 2;
+}
+
+// Walks the grid cells pierced by a ray (DDA), starting with the cell containing the origin. The visitor is called with
+// every cell entered, and may return false to stop early. Traversal also stops at the first set cell, which is visited
+// too. Returns the point where the ray entered the last visited cell.
+template<typename Visitor>
+glm::vec2 grid_raycast(const bit_grid_t& grid, glm::vec2 origin, glm::vec2 direction, Visitor&& visitor)
+{
+    grid_ray_t ray = make_grid_ray(origin, direction);
+
+    float distance = 0.0f;
+
+    if(!visitor(ray.cell) || grid.get(ray.cell))
+        return origin;
+
+    const int32_t max_steps = grid_raycast_max_steps(grid);
+
+    for(int32_t steps = 0; steps < max_steps; ++steps)
+    {
+        if(ray.side_distance.x < ray.side_distance.y)
+        {
+            distance = ray.side_distance.x;
+            ray.side_distance.x += ray.delta_distance.x;
+            ray.cell.x += ray.step_direction.x;
+        }
+        else
+        {
+            distance = ray.side_distance.y;
+            ray.side_distance.y += ray.delta_distance.y;
+            ray.cell.y += ray.step_direction.y;
+        }
+
+        if(!visitor(ray.cell) || grid.get(ray.cell))
+            break;
+    }
+
+    return origin + direction * distance;
+}
+
+} // namespace math
+} // namespace mau
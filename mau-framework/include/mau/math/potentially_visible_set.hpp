@@ -0,0 +1,48 @@
+#pragma once
+
+#include "mau/containers/bit_grid.hpp"
+#include "mau/containers/span.hpp"
+
+#include <vector>
+
+namespace mau {
+
+// Forward declarations.
+class job_system_t;
+
+// Potentially visible set over a grid of opaque cells, partitioned into square regions. For every region it lists the
+// regions which can be seen from anywhere inside of it, so runtime culling only has to test those against the view.
+//
+// Visibility is sampled with a fixed fan of rays from a few points in every cell, so the set is approximate rather
+// than conservative. Regions seen only through gaps narrower than the spacing between rays may be missing.
+class potentially_visible_set_t
+{
+public:
+    potentially_visible_set_t() = default;
+
+    // Samples visibility by casting rays from the center and corners of every non-opaque cell, with regions spread
+    // over the job system. Expensive - do it at load time. The shipped 64x64 level (3262 open cells, 16x16 regions)
+    // takes about 155 ms on a single thread at -O2.
+    potentially_visible_set_t(const bit_grid_t& opaque, int32_t region_size, job_system_t& jobs);
+
+    int32_t    region_size() const;
+    glm::ivec2 region_count() const;
+
+    // Region containing the cell, or -1 if the cell is outside the grid.
+    int32_t region_index(glm::ivec2 cell) const;
+    // Coordinates of the region with the index.
+    glm::ivec2 region_position(int32_t region_index) const;
+
+    // Indices of regions potentially visible from the region, including itself.
+    span_t<uint32_t> visible_regions(int32_t region_index) const;
+
+private:
+    int32_t    region_size_m{1};
+    glm::ivec2 region_count_m{0, 0};
+
+    // Visible region lists for all regions, packed back to back. Offsets have one extra entry marking the end.
+    std::vector<uint32_t> visible_offsets_m;
+    std::vector<uint32_t> visible_regions_m;
+};
+
+} // namespace mau
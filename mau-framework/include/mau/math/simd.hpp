@@ -0,0 +1,110 @@
+#pragma once
+
+#include "mau/base/types.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MAU_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace mau {
+namespace math {
+
+// Four packed floats. Maps onto an SSE register where available and falls back to plain scalar code elsewhere, so
+// callers can write a single data-parallel loop body for both.
+struct float4_t
+{
+#ifdef MAU_SIMD_SSE2
+    __m128 value;
+#else
+    float value[4];
+#endif
+};
+
+// Number of lanes processed by a single float4_t operation.
+inline static constexpr size_t float4_width_k = 4;
+
+// Loads four consecutive floats. No alignment requirement.
+inline float4_t load4(const float* data)
+{
+#ifdef MAU_SIMD_SSE2
+    return {_mm_loadu_ps(data)};
+#else
+    return {{data[0], data[1], data[2], data[3]}};
+#endif
+}
+
+// Stores four consecutive floats. No alignment requirement.
+inline void store4(float* data, float4_t a)
+{
+#ifdef MAU_SIMD_SSE2
+    _mm_storeu_ps(data, a.value);
+#else
+    for(size_t i = 0; i < float4_width_k; ++i)
+        data[i] = a.value[i];
+#endif
+}
+
+// Broadcasts a single value to all lanes.
+inline float4_t splat4(float value)
+{
+#ifdef MAU_SIMD_SSE2
+    return {_mm_set1_ps(value)};
+#else
+    return {{value, value, value, value}};
+#endif
+}
+
+inline float4_t operator+(float4_t a, float4_t b)
+{
+#ifdef MAU_SIMD_SSE2
+    return {_mm_add_ps(a.value, b.value)};
+#else
+    return {{a.value[0] + b.value[0], a.value[1] + b.value[1], a.value[2] + b.value[2], a.value[3] + b.value[3]}};
+#endif
+}
+
+inline float4_t operator-(float4_t a, float4_t b)
+{
+#ifdef MAU_SIMD_SSE2
+    return {_mm_sub_ps(a.value, b.value)};
+#else
+    return {{a.value[0] - b.value[0], a.value[1] - b.value[1], a.value[2] - b.value[2], a.value[3] - b.value[3]}};
+#endif
+}
+
+inline float4_t operator*(float4_t a, float4_t b)
+{
+#ifdef MAU_SIMD_SSE2
+    return {_mm_mul_ps(a.value, b.value)};
+#else
+    return {{a.value[0] * b.value[0], a.value[1] * b.value[1], a.value[2] * b.value[2], a.value[3] * b.value[3]}};
+#endif
+}
+
+inline float4_t min4(float4_t a, float4_t b)
+{
+#ifdef MAU_SIMD_SSE2
+    return {_mm_min_ps(a.value, b.value)};
+#else
+    float4_t result;
+    for(size_t i = 0; i < float4_width_k; ++i)
+        result.value[i] = a.value[i] < b.value[i] ? a.value[i] : b.value[i];
+    return result;
+#endif
+}
+
+inline float4_t max4(float4_t a, float4_t b)
+{
+#ifdef MAU_SIMD_SSE2
+    return {_mm_max_ps(a.value, b.value)};
+#else
+    float4_t result;
+    for(size_t i = 0; i < float4_width_k; ++i)
+        result.value[i] = a.value[i] > b.value[i] ? a.value[i] : b.value[i];
+    return result;
+#endif
+}
+
+} // namespace math
+} // namespace mau
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "mau/containers/span.hpp"
+#include "mau/math/algorithms.hpp"
+#include "mau/math/potentially_visible_set.hpp"
+
+#include <vector>
+
+namespace mau {
+
+// Per-frame view culling on top of a potentially visible set. Results live in flat arrays stamped with a frame
+// counter, so once sized for the set, a query neither allocates nor has to clear anything between frames.
+class visibility_query_t
+{
+public:
+    visibility_query_t() = default;
+    explicit visibility_query_t(const potentially_visible_set_t& set);
+
+    // Starts a new frame, collecting regions potentially visible from the origin which intersect the view wedge.
+    void begin_frame(glm::vec2 origin, glm::vec2 direction, float half_angle);
+
+    // Counter of the current frame. Never zero, so zero initialized stamps are never visible.
+    uint32_t frame() const;
+
+    bool             region_visible(int32_t region_index) const;
+    span_t<uint32_t> visible_regions() const;
+
+    // Returns true if the 2D box intersects the view wedge and the region containing its center is visible.
+    bool box_visible(glm::vec2 box_min, glm::vec2 box_max) const;
+
+private:
+    const potentially_visible_set_t* set_m{nullptr};
+
+    math::view_wedge_t wedge_m;
+    uint32_t           frame_m{0};
+
+    // Frame on which each region was last found visible, and the regions visible this frame.
+    std::vector<uint32_t> region_frames_m;
+    std::vector<uint32_t> visible_regions_m;
+};
+
+inline uint32_t visibility_query_t::frame() const
+{
+    return frame_m;
+}
+
+inline bool visibility_query_t::region_visible(int32_t region_index) const
+{
+    return region_index >= 0 && region_frames_m[region_index] == frame_m;
+}
+
+inline bool visibility_query_t::box_visible(glm::vec2 box_min, glm::vec2 box_max) const
+{
+    const glm::ivec2 center_cell = glm::floor((box_min + box_max) / 2.0f);
+    if(!region_visible(set_m->region_index(center_cell)))
+        return false;
+
+    return math::aabb_view_wedge_intersect(box_min, box_max, wedge_m);
+}
+
+} // namespace mau
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "mau/base/types.hpp"
+
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace mau {
+
+// Pool of fixed-size slots for objects of a single type. Slots are carved out of blocks which are never returned to the
+// system, so once the pool has grown to the peak object count, creating and destroying objects doesn't touch the heap.
+template<typename T, size_t BlockSize = 64>
+class object_pool_t : non_copyable_t, non_movable_t
+{
+public:
+    // Constructs an object in a free slot, growing the pool by a block if none are left.
+    template<typename... Args>
+    T* create(Args&&... args);
+
+    // Destroys an object previously created by this pool and makes its slot available again.
+    void destroy(T* object);
+
+    size_t size() const;
+    size_t capacity() const;
+
+private:
+    union slot_t
+    {
+        slot_t* next;
+        alignas(T) byte_t storage[sizeof(T)];
+    };
+
+    void grow();
+
+    std::vector<std::unique_ptr<slot_t[]>> blocks_m;
+
+    slot_t* free_list_m{nullptr};
+    size_t  size_m{0};
+};
+
+template<typename T, size_t BlockSize>
+template<typename... Args>
+inline T* object_pool_t<T, BlockSize>::create(Args&&... args)
+{
+    if(!free_list_m)
+        grow();
+
+    slot_t* slot = free_list_m;
+    free_list_m  = slot->next;
+
+    try
+    {
+        T* object = new(slot->storage) T(std::forward<Args>(args)...);
+        ++size_m;
+        return object;
+    }
+    catch(...)
+    {
+        slot->next  = free_list_m;
+        free_list_m = slot;
+        throw;
+    }
+}
+
+template<typename T, size_t BlockSize>
+inline void object_pool_t<T, BlockSize>::destroy(T* object)
+{
+    if(!object)
+        return;
+
+    object->~T();
+
+    slot_t* slot = reinterpret_cast<slot_t*>(object);
+    slot->next   = free_list_m;
+    free_list_m  = slot;
+
+    --size_m;
+}
+
+template<typename T, size_t BlockSize>
+inline size_t object_pool_t<T, BlockSize>::size() const
+{
+    return size_m;
+}
+
+template<typename T, size_t BlockSize>
+inline size_t object_pool_t<T, BlockSize>::capacity() const
+{
+    return blocks_m.size() * BlockSize;
+}
+
+template<typename T, size_t BlockSize>
+inline void object_pool_t<T, BlockSize>::grow()
+{
+    blocks_m.push_back(std::make_unique<slot_t[]>(BlockSize));
+    slot_t* block = blocks_m.back().get();
+
+    // Thread the new slots onto the free list in address order.
+    for(size_t i = BlockSize; i > 0; --i)
+    {
+        block[i - 1].next = free_list_m;
+        free_list_m       = &block[i - 1];
+    }
+}
+
+} // namespace mau
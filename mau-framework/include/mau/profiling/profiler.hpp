@@ -0,0 +1,132 @@
+#pragma once
+
+#include "mau/base/types.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Times the rest of the enclosing scope as a zone of the given name, which must be a string literal.
+#define MAU_PROFILE_ZONE(name) ::mau::profile_zone_t MAU_PROFILE_CONCAT(profile_zone_, __LINE__){name}
+
+#define MAU_PROFILE_CONCAT(a, b) MAU_PROFILE_CONCAT_IMPL(a, b)
+#define MAU_PROFILE_CONCAT_IMPL(a, b) a##b
+
+namespace mau {
+
+// Time spent in a zone over a frame, summed over all calls on all threads.
+struct profile_zone_summary_t
+{
+    const char* name;
+
+    // Nesting depth of the zone's first call, for indenting breakdowns.
+    uint32_t depth;
+    uint32_t calls;
+    double   seconds;
+};
+
+// Collects timed zones from all threads. Every thread records into a ring buffer of its own, so recording takes no
+// locks, and only the latest zones are kept. Zones are summarized per frame and can be exported as a Chrome trace.
+//
+// Buffers are read while summarizing and exporting, which must therefore happen while no other thread records, such as
+// between parallel loops.
+class profiler_t : non_copyable_t, non_movable_t
+{
+public:
+    // Zones kept per thread.
+    static constexpr size_t ring_capacity_k = 1U << 16;
+
+    // Zones report to the latest profiler created, until it's destroyed.
+    explicit profiler_t();
+    ~profiler_t();
+
+    // Profiler zones report to, or nullptr if there's none.
+    static profiler_t* active();
+
+    // Names the calling thread in traces. Takes effect for profilers the thread hasn't recorded into yet.
+    static void set_thread_name(std::string name);
+
+    // Profilers start disabled, in which case zones cost next to nothing.
+    void set_enabled(bool enabled);
+    bool enabled() const;
+
+    // Marks the start of a frame and summarizes the frame before.
+    void begin_frame();
+
+    // Zones of the latest complete frame, in the order they were first entered.
+    const std::vector<profile_zone_summary_t>& frame_summary() const;
+
+    // Writes the recorded zones in Chrome's trace event format, viewable in chrome://tracing or Perfetto. Throws on
+    // failure.
+    void save_chrome_trace(const std::string& path) const;
+
+    // Called by zones. Entering returns the current time in nanoseconds.
+    uint64_t enter_zone();
+    void     leave_zone(const char* name, uint64_t begin);
+
+private:
+    struct event_t
+    {
+        const char* name;
+        uint64_t    begin;
+        uint64_t    end;
+        uint32_t    depth;
+    };
+
+    struct thread_buffer_t
+    {
+        std::string           name;
+        uint32_t              thread_id;
+        std::vector<event_t>  events;
+        std::atomic<uint64_t> written{0};
+        uint32_t              depth{0};
+    };
+
+    thread_buffer_t& thread_buffer();
+
+    void summarize(uint64_t begin, uint64_t end);
+
+    // Distinguishes profilers from ones which used to live at the same address.
+    uint64_t id_m;
+    uint64_t epoch_m;
+
+    std::atomic<bool> enabled_m{false};
+    uint64_t          frame_start_m{0};
+
+    mutable std::mutex                            buffers_mutex_m;
+    std::vector<std::unique_ptr<thread_buffer_t>> buffers_m;
+
+    std::vector<profile_zone_summary_t> frame_summary_m;
+};
+
+// Records the time between its construction and destruction as a zone of the active profiler, if it's enabled.
+class profile_zone_t : non_copyable_t, non_movable_t
+{
+public:
+    explicit profile_zone_t(const char* name);
+    ~profile_zone_t();
+
+private:
+    profiler_t* profiler_m;
+    const char* name_m;
+    uint64_t    begin_m{0};
+};
+
+inline profile_zone_t::profile_zone_t(const char* name) : profiler_m(profiler_t::active()), name_m(name)
+{
+    if(profiler_m && !profiler_m->enabled())
+        profiler_m = nullptr;
+
+    if(profiler_m)
+        begin_m = profiler_m->enter_zone();
+}
+
+inline profile_zone_t::~profile_zone_t()
+{
+    if(profiler_m)
+        profiler_m->leave_zone(name_m, begin_m);
+}
+
+} // namespace mau
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "mau/containers/radix_sort.hpp"
+#include "mau/containers/span.hpp"
+#include "mau/math/matrix.hpp"
+#include "mau/rendering/shader.hpp"
+#include "mau/rendering/texture.hpp"
+#include "mau/rendering/vertex_object.hpp"
+
+#include <array>
+#include <vector>
+
+namespace mau {
+
+// Forward declarations.
+class renderer_t;
+
+// Passes run in order. Within a pass, draws are grouped by shader and then by texture, and go front to back, so
+// nearer draws hide farther ones from the depth test before they're shaded. Translucent draws go back to front
+// instead, so they blend over whatever is behind them.
+enum class draw_pass_t : uint8_t
+{
+    opaque_k,
+    alpha_tested_k,
+    translucent_k
+};
+
+// A draw submitted to the queue, along with the state it needs.
+struct draw_command_t
+{
+    shader_handle_t                 shader;
+    std::array<texture_handle_t, 2> textures;
+
+    // Vertices drawn, or nullptr for vertices pushed into the queue.
+    vertex_object_handle_t vertex_object;
+    uint32_t               first{0};
+    uint32_t               count{0};
+
+    // If set, first and count refer to ranges pushed into the queue instead, which are drawn with a single multi-draw.
+    bool multi_draw{false};
+
+    glm::mat4 model_matrix{1.0f};
+};
+
+// Vertex ranges of multi-draw commands, stored back to back. Commands refer to their ranges by the index of the first
+// one and their count.
+class draw_ranges_t
+{
+public:
+    // Returns the index of the first range pushed.
+    uint32_t push(span_t<int32_t> firsts, span_t<int32_t> counts);
+
+    span_t<int32_t> firsts(uint32_t first, uint32_t count) const;
+    span_t<int32_t> counts(uint32_t first, uint32_t count) const;
+
+    size_t size() const;
+    void   clear();
+
+private:
+    std::vector<int32_t> firsts_m;
+    std::vector<int32_t> counts_m;
+};
+
+// Queue of draws, which are sorted by a key before they're executed. Keys hold, from most to least significant bits,
+// the pass in 4 bits, the shader in 12, the diffuse texture in 16 and the depth in 32.
+class draw_queue_t : non_copyable_t, non_movable_t
+{
+public:
+    explicit draw_queue_t(renderer_t& renderer);
+
+    // Depth is the distance from the camera, which must not be negative.
+    static uint64_t sort_key(draw_pass_t pass, uint32_t shader_id, uint32_t texture_id, float depth);
+
+    // Bits of a depth, which order the same way as depths do, so they can be used as radix sort keys.
+    static uint32_t depth_bits(float depth);
+
+    // Camera position depths are measured from.
+    void  set_camera_position(glm::vec3 position);
+    float depth(glm::vec3 position) const;
+
+    // Copies vertices into the queue, returning the index of the first one. They're drawn by commands without a vertex
+    // object, and uploaded all at once when the queue is executed.
+    uint32_t push_vertices(span_t<vertex_t> vertices);
+
+    // Copies vertex ranges into the queue, returning the index of the first one, for multi-draw commands.
+    uint32_t push_ranges(span_t<int32_t> firsts, span_t<int32_t> counts);
+
+    void submit(draw_pass_t pass, float depth, draw_command_t command);
+
+    // Executes the queued draws in key order and empties the queue. Leaves the shader of the last draw bound.
+    void execute();
+
+    size_t size() const;
+
+private:
+    renderer_t& renderer_m;
+
+    glm::vec3 camera_position_m{0.0f};
+
+    std::vector<draw_command_t>     commands_m;
+    std::vector<radix_sort_entry_t> keys_m;
+    std::vector<radix_sort_entry_t> sort_scratch_m;
+
+    // Streamed vertices, along with the vertex object they're uploaded into, which is created on first use.
+    std::vector<vertex_t>  vertices_m;
+    vertex_object_handle_t vertex_object_m;
+
+    // Vertex ranges of multi-draw commands.
+    draw_ranges_t ranges_m;
+};
+
+} // namespace mau
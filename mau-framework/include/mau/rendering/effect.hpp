@@ -10,7 +10,7 @@ namespace mau {
 // Forward declaration.
 class engine_context_t;
 
-// Chainable screen-space effect. Applied to render targets.
+// Chainable screen-space effect. Applied to render targets, through render passes into render targets of its own.
 class effect_t : non_movable_t, non_copyable_t
 {
 public:
@@ -2,8 +2,11 @@
 
 #include "mau/io/resource.hpp"
 #include "mau/math/vector.hpp"
+#include "mau/rendering/geometry.hpp"
 #include "mau/rendering/texture.hpp"
 
+#include <vector>
+
 namespace mau {
 
 // Forward declarations.
@@ -20,6 +23,9 @@ public:
 
     texture_handle_t texture();
 
+    // Appends the triangles of a character, along with its shadow if the font has one.
+    void append_glyph(std::vector<vertex_t>& vertices, glm::vec2 position, char character, glm::vec4 color) const;
+
     // Horizontal and vertical character count.
     const glm::ivec2 character_count;
 
@@ -9,6 +9,7 @@ namespace mau {
 
 struct vertex_t
 {
+    vertex_t() = default;
     vertex_t(glm::vec3 position);
     vertex_t(glm::vec3 position, glm::vec2 uv);
     vertex_t(glm::vec3 position, glm::vec2 uv, glm::vec4 color);
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "mau/base/types.hpp"
+#include "mau/math/matrix.hpp"
+
+#include <array>
+
+namespace mau {
+
+inline static constexpr size_t pass_constants_max_lights_k = 32;
+
+// Constants shared by all draws of a pass, kept in a uniform buffer rather than set on every shader. Shaders declare
+// them as the uniform block below, which is bound to the buffer when the shader is linked.
+//
+// layout(std140) uniform PassConstants
+// {
+//     mat4  uniformView;
+//     mat4  uniformProjection;
+//     vec2  uniformResolution;
+//     float uniformFogDensity;
+//     int   uniformLightCount;
+//     vec4  uniformLightPositions[32];
+//     vec4  uniformLightColors[32];
+// };
+//
+// Members are laid out to match std140 without any padding, so the struct is uploaded as is.
+struct pass_constants_t
+{
+    glm::mat4 view{1.0f};
+    glm::mat4 projection{1.0f};
+    glm::vec2 resolution{0.0f};
+    float     fog_density{0.0f};
+    int32_t   light_count{0};
+
+    // Positions with the radius in w, and colors with w unused.
+    std::array<glm::vec4, pass_constants_max_lights_k> light_positions{};
+    std::array<glm::vec4, pass_constants_max_lights_k> light_colors{};
+};
+
+static_assert(sizeof(pass_constants_t) == 1168, "pass_constants_t must match the std140 layout of PassConstants");
+
+inline static constexpr const char* pass_constants_block_k   = "PassConstants";
+inline static constexpr uint32_t    pass_constants_binding_k = 0;
+
+} // namespace mau
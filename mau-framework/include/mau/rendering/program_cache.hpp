@@ -0,0 +1,53 @@
+#pragma once
+
+#include "mau/base/types.hpp"
+
+#include <string>
+#include <string_view>
+
+namespace mau {
+
+// Forward declarations.
+class log_t;
+
+// On-disk cache of linked shader programs, so they don't have to be compiled from source on every launch. Binaries
+// are keyed by a hash of their sources along with the GL vendor, renderer and version, and stored one per file.
+//
+// The driver is identified on first use, which must therefore happen after the GL context is created. Drivers without
+// program binary support leave the cache disabled, and so does an empty directory.
+class program_cache_t : non_copyable_t, non_movable_t
+{
+public:
+    explicit program_cache_t(std::string directory, log_t& log);
+
+    bool enabled();
+
+    // Loads the binary of the program built from the sources into it. Returns false if there's none, or if the driver
+    // rejects it, in which case the program must be linked from source.
+    bool load(gl_handle_t program, std::string_view vertex_source, std::string_view fragment_source);
+
+    // Stores the binary of a program linked from the sources. Programs must be linked with
+    // GL_PROGRAM_BINARY_RETRIEVABLE_HINT set. Failing to write is logged, but otherwise ignored.
+    void store(gl_handle_t program, std::string_view vertex_source, std::string_view fragment_source);
+
+    // Programs loaded from the cache, and programs which had to be linked from source, whether the cache is enabled
+    // or not.
+    uint32_t hits() const;
+    uint32_t misses() const;
+
+private:
+    uint64_t    program_key(std::string_view vertex_source, std::string_view fragment_source) const;
+    std::string program_path(uint64_t key) const;
+
+    std::string directory_m;
+    log_t&      log_m;
+
+    bool     initialized_m{false};
+    bool     supported_m{false};
+    uint64_t driver_hash_m{0};
+
+    uint32_t hits_m{0};
+    uint32_t misses_m{0};
+};
+
+} // namespace mau
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "mau/math/vector.hpp"
+#include "mau/rendering/render_target.hpp"
+#include "mau/rendering/shader.hpp"
+#include "mau/rendering/texture.hpp"
+
+#include <array>
+#include <optional>
+
+namespace mau {
+
+enum class framebuffer_render_mode_t
+{
+    fill_ndc_k,
+    perform_aspect_correction_k
+};
+
+// Describes a pass drawing into a render target: where it draws, what it samples, which shader it draws with and what
+// gets cleared first. Beginning a pass only touches the state the pass differs in from the bound one.
+struct render_pass_t
+{
+    // Render target drawn into, or nullptr for the window.
+    render_target_handle_t target;
+
+    // Shader bound for the pass, or nullptr to leave the bound one.
+    shader_handle_t shader;
+
+    // Textures bound to the texture units in order. Units after the first empty input are left alone.
+    std::array<texture_handle_t, 4> inputs;
+
+    // Color the target is cleared to before drawing, if any, and whether its depth is cleared as well.
+    std::optional<glm::vec4> clear_color{};
+    bool                     clear_depth{false};
+
+    // Whether a pass into the window fills it, or is letterboxed to the aspect ratio of the viewport.
+    framebuffer_render_mode_t mode{framebuffer_render_mode_t::fill_ndc_k};
+};
+
+} // namespace mau
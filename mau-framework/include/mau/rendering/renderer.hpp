@@ -5,8 +5,11 @@
 #include "mau/math/matrix.hpp"
 #include "mau/memory/value_container.hpp"
 #include "mau/rendering/depth_test_lock.hpp"
+#include "mau/rendering/draw_queue.hpp"
 #include "mau/rendering/font.hpp"
 #include "mau/rendering/geometry.hpp"
+#include "mau/rendering/pass_constants.hpp"
+#include "mau/rendering/render_pass.hpp"
 #include "mau/rendering/render_target.hpp"
 #include "mau/rendering/shader.hpp"
 #include "mau/rendering/texture.hpp"
@@ -16,6 +19,7 @@
 #include <SDL.h>
 
 #include <array>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -23,22 +27,43 @@ namespace mau {
 
 using renderer_exception_t = exception_t;
 
-enum class framebuffer_render_mode_t
-{
-    fill_ndc_k,
-    perform_aspect_correction_k
-};
-
 enum class fill_mode_t
 {
     wireframe_k,
     fill_k
 };
 
+enum class blend_mode_t
+{
+    disabled_k,
+    alpha_k,   // Blends over the destination by source alpha.
+    additive_k // Adds onto the destination.
+};
+
+// Work submitted by the renderer over a frame.
+struct render_counters_t
+{
+    uint32_t draw_calls{0};
+    uint32_t buffer_uploads{0};
+    uint64_t uploaded_bytes{0};
+    uint32_t texture_binds{0};
+    uint32_t shader_switches{0};
+};
+
+// GPU time taken by a pass over a frame, summed over all of its runs.
+struct gpu_pass_time_t
+{
+    const char* name;
+    double      seconds;
+};
+
 // renderer_t class.
 class renderer_t : public module_t
 {
 public:
+    // Texture units the renderer binds textures to, one for every texture uniform of shaders.
+    static constexpr uint32_t texture_unit_count_k = 4;
+
     explicit renderer_t(engine_context_t& engine);
     ~renderer_t();
 
@@ -53,26 +78,68 @@ public:
     void        set_fill_mode(fill_mode_t fill_mode);
     fill_mode_t fill_mode();
 
+    void         set_blend_mode(blend_mode_t blend_mode);
+    blend_mode_t blend_mode() const;
+
     // Set vsync regardless of configuration.
     void set_vsync(bool enabled);
     // Restore vsync setting to configuration-specified.
     void restore_vsync();
 
+    // State changes are shadowed, and skipped when they wouldn't change anything. Bound state must therefore only be
+    // changed through the renderer.
     void bind_shader(shader_handle_t shader);
     void bind_render_target(render_target_handle_t render_target);
     void bind_texture(texture_handle_t texture, uint32_t texture_unit);
 
     void clear_render_target();
 
+    // Uploads constants for the draws that follow, unless they're unchanged.
+    void set_pass_constants(const pass_constants_t& constants);
+
+    // Binds the pass's target, inputs and shader, and clears the target as asked. Draw calls after it go into the pass,
+    // until another one begins or a render target is bound.
+    void begin_render_pass(const render_pass_t& pass);
+
+    // Begins the pass and covers its target with the fullscreen triangle.
+    void draw_fullscreen_pass(const render_pass_t& pass);
+
     void present();
 
     void render_vertex_object(vertex_object_handle_t vertex_array);
+    void render_vertex_object(vertex_object_handle_t vertex_array, size_t first, size_t count);
+
+    // Draws several ranges of the vertex object with a single multi-draw call.
+    void render_vertex_object_ranges(vertex_object_handle_t vertex_object,
+                                     span_t<int32_t>        firsts,
+                                     span_t<int32_t>        counts);
 
-    // Batching.
+    // Covers the bound render target with a single triangle, with texture coordinates running from 0 to 1 across it.
+    // The triangle lives in a static vertex object, so nothing is uploaded.
+    void render_fullscreen_triangle();
+
+    // Replaces the vertices of the vertex object, counting the upload.
+    void upload_vertices(vertex_object_handle_t vertex_object, span_t<vertex_t> vertices);
+
+    // Times the GPU work submitted between the calls as a pass of the given name, which must be a string literal.
+    // Passes are timed with GL_TIME_ELAPSED queries, which can't overlap, so passes mustn't nest.
+    void begin_gpu_pass(const char* name);
+    void end_gpu_pass();
+
+    // Pass times of the latest frame whose results have come in. Results are read a frame late, and frames whose
+    // results are late still are skipped, so reading them never stalls.
+    const std::vector<gpu_pass_time_t>& gpu_pass_times() const;
+
+    // Counters of the latest presented frame.
+    const render_counters_t& frame_counters() const;
+
+    // Draws submitted to the queue are sorted to cut down on state changes, and executed when asked to.
+    draw_queue_t& draw_queue();
+
+    // Batching. Strings don't bind the font texture, which is up to the owner of the batch, once for all of it.
     void batch_sprite(vertex_batch_t& batch, glm::vec2 position, glm::vec2 size, glm::vec4 color);
     void batch_character(vertex_batch_t& batch, font_handle_t font, glm::vec2 position, char character, glm::vec4 color);
     void batch_string(vertex_batch_t& batch, font_handle_t font, glm::vec2 position, std::string_view string, glm::vec4 color);
-    void batch_framebuffer_fullscreen(vertex_batch_t& batch, framebuffer_render_mode_t mode);
 
     std::vector<vertex_t>& batch_vertices();
     vertex_object_handle_t batch_vertex_object();
@@ -82,12 +149,72 @@ public:
     glm::vec2 viewport_size() const;
 
 private:
+    // Queries of a frame. Pending until their results are read, and only reused after that.
+    struct gpu_query_frame_t
+    {
+        std::vector<const char*> names;
+        std::vector<gl_handle_t> queries;
+        size_t                   used{0};
+        bool                     pending{false};
+    };
+
+    // Framebuffer and viewport changes go through these, which skip them when they're already in place.
+    void bind_framebuffer(render_target_handle_t render_target);
+    void set_viewport(glm::ivec4 viewport);
+
+    // Reads the results of a pending frame's queries, if they're all in, and makes its queries available again.
+    // Returns false if the frame is still pending.
+    bool collect_gpu_pass_times(gpu_query_frame_t& frame);
+
     value_container_t<SDL_GLContext, decltype(&SDL_GL_DeleteContext)> gl_context_m;
 
     shader_handle_t passthrough_shader_m;
 
+    // Uniform buffer holding the pass constants, along with the ones uploaded latest.
+    gl_handle_t                     pass_constants_buffer_m{0};
+    std::optional<pass_constants_t> pass_constants_m;
+
+    // Shadowed GL state, which is never read back from the driver. Bound objects are held on to, so their GL names
+    // can't be handed to other objects while they're still thought to be bound. The window is bound as nullptr, and so
+    // are empty texture units. The viewport is x, y, width and height.
+    shader_handle_t                                     bound_shader_m;
+    render_target_handle_t                              bound_render_target_m;
+    std::array<texture_handle_t, texture_unit_count_k> bound_textures_m;
+    uint32_t                                            active_texture_unit_m{0};
+    glm::ivec4                                          viewport_m{0};
+    depth_test_t                                        depth_test_m{depth_test_t::enabled_k};
+    blend_mode_t                                        blend_mode_m{blend_mode_t::alpha_k};
+    fill_mode_t                                         fill_mode_m{fill_mode_t::fill_k};
+
     std::vector<vertex_t>  batch_vertices_m;
     vertex_object_handle_t batch_vertex_object_m;
+    vertex_object_handle_t fullscreen_triangle_m;
+
+    draw_queue_t draw_queue_m{*this};
+
+    render_counters_t counters_m;
+    render_counters_t frame_counters_m;
+
+    // Ring of query frames, the one being recorded and the ones before, whose results are read once they're in. If
+    // the GPU falls so far behind that the ring comes back around to a pending frame, that frame's passes go untimed.
+    static constexpr size_t gpu_query_frame_count_k = 4;
+
+    std::array<gpu_query_frame_t, gpu_query_frame_count_k> gpu_query_frames_m;
+    size_t                                                 gpu_query_frame_m{0};
+    bool                                                   gpu_pass_active_m{false};
+    bool                                                   gpu_query_active_m{false};
+    std::vector<gpu_pass_time_t>                           gpu_pass_times_m;
+};
+
+// Times GPU work as a pass for as long as it lives.
+class gpu_pass_guard_t : non_copyable_t, non_movable_t
+{
+public:
+    gpu_pass_guard_t(renderer_t& renderer, const char* name);
+    ~gpu_pass_guard_t();
+
+private:
+    renderer_t& renderer_m;
 };
 
 } // namespace mau
@@ -4,7 +4,9 @@
 #include "mau/io/resource.hpp"
 #include "mau/math/matrix.hpp"
 
+#include <array>
 #include <map>
+#include <memory>
 #include <string>
 
 namespace mau {
@@ -17,49 +19,44 @@ enum class shader_uniform_t
     texture2_k,
     texture3_k,
 
-    // Specific
+    // Specific. View, projection, resolution, fog and lights are pass constants, see pass_constants_t.
     model_matrix_k,
-    view_matrix_k,
-    projection_matrix_k,
-
-    enable_lighting_k,
-    enable_emission_k,
-    enable_fog_k,
-    enable_sprite_billboarding_k,
-    enable_particle_mode_k,
-
-    fog_density_k,
     particle_size_k,
-    pass_k,
-    resolution_k,
-
-    light_count_k,
-    light_positions_k,
-    light_colors_k,
-    light_radii_k
+    pass_k
 };
 
+inline static constexpr size_t shader_uniform_count_k = static_cast<size_t>(shader_uniform_t::pass_k) + 1;
+
 inline static constexpr std::pair<shader_uniform_t, const char*> shader_uniform_mapping_k[] = {
     {shader_uniform_t::texture0_k, "uniformTexture0"},
     {shader_uniform_t::texture1_k, "uniformTexture1"},
     {shader_uniform_t::texture2_k, "uniformTexture2"},
     {shader_uniform_t::texture3_k, "uniformTexture3"},
     {shader_uniform_t::model_matrix_k, "uniformModel"},
-    {shader_uniform_t::view_matrix_k, "uniformView"},
-    {shader_uniform_t::projection_matrix_k, "uniformProjection"},
-    {shader_uniform_t::enable_sprite_billboarding_k, "uniformEnableSpriteBillboarding"},
     {shader_uniform_t::pass_k, "uniformPass"},
-    {shader_uniform_t::resolution_k, "uniformResolution"},
-    {shader_uniform_t::enable_lighting_k, "uniformEnableLighting"},
-    {shader_uniform_t::enable_emission_k, "uniformEnableEmission"},
-    {shader_uniform_t::enable_fog_k, "uniformEnableFog"},
-    {shader_uniform_t::fog_density_k, "uniformFogDensity"},
-    {shader_uniform_t::enable_particle_mode_k, "uniformEnableParticleMode"},
     {shader_uniform_t::particle_size_k, "uniformParticleSize"},
-    {shader_uniform_t::light_count_k, "uniformLightCount"},
-    {shader_uniform_t::light_positions_k, "uniformLightPositions"},
-    {shader_uniform_t::light_colors_k, "uniformLightColors"},
-    {shader_uniform_t::light_radii_k, "uniformLightRadii"},
+};
+
+// Features shaders can be specialized for, as a bitmask. Shaders list the features they support in their descriptor,
+// and every variant is compiled with a #define for each of its features, so it doesn't branch on them at runtime.
+using shader_features_t = uint32_t;
+
+namespace shader_features {
+
+inline constexpr shader_features_t lighting_k            = 1U << 0;
+inline constexpr shader_features_t emission_k            = 1U << 1;
+inline constexpr shader_features_t fog_k                 = 1U << 2;
+inline constexpr shader_features_t sprite_billboarding_k = 1U << 3;
+inline constexpr shader_features_t particle_mode_k       = 1U << 4;
+
+} // namespace shader_features
+
+inline static constexpr std::pair<shader_features_t, const char*> shader_feature_mapping_k[] = {
+    {shader_features::lighting_k, "LIGHTING"},
+    {shader_features::emission_k, "EMISSION"},
+    {shader_features::fog_k, "FOG"},
+    {shader_features::sprite_billboarding_k, "SPRITE_BILLBOARDING"},
+    {shader_features::particle_mode_k, "PARTICLE_MODE"},
 };
 
 enum class texture_unit_t
@@ -71,27 +68,52 @@ enum class texture_unit_t
 };
 
 // Forward declaration.
+class program_cache_t;
 class shader_t;
 
 using shader_handle_t     = std::shared_ptr<shader_t>;
 using gl_uniform_handle_t = int32_t;
 
-class shader_t : public resource_t
+// Shader program. Uniform values are shadowed, so setting a uniform to the value it already has costs no GL call.
+// Uniforms are set on the bound program, so the shader must be bound when setting them.
+//
+// Shader descriptors are "vertex.vs;fragment.fs", optionally followed by ";" and a comma separated list of supported
+// features, such as "ubershader.vs;ubershader.fs;LIGHTING,FOG".
+class shader_t : public resource_t, public std::enable_shared_from_this<shader_t>
 {
 public:
-    static shader_handle_t create(file_handle_t vertex_file, file_handle_t fragment_file);
-
-    shader_t(file_handle_t vertex_file, file_handle_t fragment_file);
+    static shader_handle_t create(file_handle_t     vertex_file,
+                                  file_handle_t     fragment_file,
+                                  shader_features_t supported_features = 0,
+                                  program_cache_t*  program_cache      = nullptr);
+
+    // Compiles the sources with the given features, which must be among the supported ones. The program is loaded
+    // from the cache instead if it's there, and stored into it otherwise. Variants share the cache, which must
+    // outlive them.
+    shader_t(std::string       vertex_source,
+             std::string       fragment_source,
+             shader_features_t supported_features,
+             shader_features_t features,
+             program_cache_t*  program_cache);
     ~shader_t();
 
+    // Program specialized for the features, compiled the first time it's asked for and cached. Features the shader
+    // doesn't support are ignored, so asking for none of them returns the shader itself.
+    shader_handle_t variant(shader_features_t features);
+
+    shader_features_t features() const;
+
     void set_uniform_mat4(shader_uniform_t uniform, const glm::mat4& value);
     void set_uniform_vec2(shader_uniform_t uniform, glm::vec2 value);
     void set_uniform_int(shader_uniform_t uniform, int32_t value);
     void set_uniform_bool(shader_uniform_t uniform, bool value);
     void set_uniform_float(shader_uniform_t uniform, float value);
+
+    // Arrays aren't shadowed, and are uploaded every time.
     void set_uniform_vec3_array(shader_uniform_t uniform, span_t<glm::vec3> values);
     void set_uniform_float_array(shader_uniform_t uniform, span_t<float> values);
 
+    // Points texture uniforms at the texture units of the same number.
     void bind_texture_units();
 
     gl_handle_t gl_handle();
@@ -99,10 +121,33 @@ public:
     static shader_handle_t create_resource(engine_context_t& engine, file_handle_t file);
 
 private:
-    gl_uniform_handle_t gl_uniform(shader_uniform_t uniform);
+    // Latest value set to a uniform, in bytes. Values are only compared with values of the same type.
+    struct uniform_value_t
+    {
+        std::array<uint8_t, sizeof(glm::mat4)> bytes;
+        bool                                   valid{false};
+    };
+
+    gl_uniform_handle_t gl_uniform(shader_uniform_t uniform) const;
+
+    // Records the value, returning false if the uniform had it already or isn't used by the shader.
+    template<typename T>
+    bool shadow_uniform(shader_uniform_t uniform, const T& value);
+
+    gl_handle_t gl_handle_m{0};
+
+    // Sources are kept for compiling variants.
+    std::string       vertex_source_m;
+    std::string       fragment_source_m;
+    shader_features_t supported_features_m;
+    shader_features_t features_m;
+    program_cache_t*  program_cache_m;
+
+    std::map<shader_features_t, shader_handle_t> variants_m;
 
-    gl_handle_t                                     gl_handle_m{0};
-    std::map<shader_uniform_t, gl_uniform_handle_t> gl_uniform_mapping_m;
+    // Indexed by uniform. Uniforms the shader doesn't use are at -1.
+    std::array<gl_uniform_handle_t, shader_uniform_count_k> gl_uniforms_m;
+    std::array<uniform_value_t, shader_uniform_count_k>     uniform_values_m;
 };
 
 } // namespace mau
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "mau/rendering/font.hpp"
+#include "mau/rendering/vertex_object.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mau {
+
+// Forward declaration.
+class renderer_t;
+
+// Vertices of text in a single font, added as glyph runs every frame. Runs matching the ones added in the same order
+// the frame before keep their vertices, so unchanged text isn't generated again. Once a run differs, it and the runs
+// after it are generated anew.
+class glyph_runs_t
+{
+public:
+    // Starts collecting the frame's runs. Changing the font discards all runs.
+    void begin(font_handle_t font);
+
+    void add_run(glm::vec2 position, std::string_view string, glm::vec4 color);
+
+    // Drops the runs left over from the frame before. Returns whether the vertices changed since the previous call.
+    bool end();
+
+    const std::vector<vertex_t>& vertices() const;
+
+    font_handle_t font() const;
+
+private:
+    struct run_t
+    {
+        std::string string;
+        glm::vec2   position;
+        glm::vec4   color;
+        size_t      first;
+        size_t      count;
+    };
+
+    // Drops the runs from the given one on, along with their vertices.
+    void truncate(size_t run);
+
+    font_handle_t font_m;
+
+    std::vector<run_t>    runs_m;
+    std::vector<vertex_t> vertices_m;
+
+    // Runs added this frame, and whether the vertices changed since the previous end.
+    size_t run_count_m{0};
+    bool   dirty_m{false};
+};
+
+// Glyph runs kept as a mesh between frames and drawn with a single draw call. Vertices are only uploaded when a run
+// changed.
+class text_mesh_t : non_copyable_t, non_movable_t
+{
+public:
+    explicit text_mesh_t(renderer_t& renderer);
+
+    void begin(font_handle_t font);
+    void add_run(glm::vec2 position, std::string_view string, glm::vec4 color);
+
+    // Uploads the vertices if any run changed, binds the font texture and draws all runs.
+    void draw();
+
+private:
+    renderer_t& renderer_m;
+
+    glyph_runs_t           runs_m;
+    vertex_object_handle_t vertex_object_m;
+};
+
+} // namespace mau
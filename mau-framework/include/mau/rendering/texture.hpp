@@ -6,6 +6,12 @@
 
 namespace mau {
 
+enum class texture_filter_t
+{
+    nearest_k,
+    linear_k
+};
+
 // Forward declarations.
 class engine_context_t;
 class texture_t;
@@ -25,6 +31,9 @@ public:
     glm::ivec2  size() const;
     gl_handle_t gl_handle() const;
 
+    // Textures are created with nearest filtering.
+    void set_filter(texture_filter_t filter);
+
     static texture_handle_t create_resource(engine_context_t& engine, file_handle_t file);
 
 private:
@@ -18,6 +18,9 @@ public:
 
     void insert(const vertex_t& vertex);
 
+    // Vertices inserted so far, which may be appended to directly.
+    std::vector<vertex_t>& vertices();
+
 private:
     renderer_t&            renderer_m;
     vertex_primitive_t     primitive_m;
@@ -35,10 +35,12 @@ public:
     vertex_object_t(vertex_primitive_t primitive, vertex_object_mode_t mode, span_t<vertex_t> vertices);
     ~vertex_object_t();
 
-    // Replace vertex object vertices with provided vertices. Note: this is an expensive operation.
+    // Replace vertex object vertices with provided vertices. Note: this is an expensive operation. Buffer storage is only
+    // reallocated when the vertices don't fit in the existing one.
     void update(span_t<vertex_t> vertices);
 
     size_t   vertex_count() const;
+    size_t   vertex_capacity() const;
     uint32_t gl_handle() const;
 
     void set_primitive(vertex_primitive_t primitive);
@@ -57,6 +59,7 @@ private:
     gl_handle_t gl_vbo_handle_m{0};
 
     size_t vertex_count_m{0};
+    size_t vertex_capacity_m{0};
 };
 
 } // namespace mau
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "mau/base/types.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace mau {
+
+// Pool of worker threads for data parallel loops. A loop is cut into ranges up front, which are dealt out to per thread
+// queues. Threads work off their own queue and steal from the others once it runs dry. The thread starting a loop works
+// on it too, rather than waiting idle.
+class job_system_t : non_copyable_t, non_movable_t
+{
+public:
+    using range_function_t = std::function<void(size_t begin, size_t end)>;
+
+    // Worker count doesn't include the calling thread. With no workers, loops simply run on the calling thread.
+    explicit job_system_t(size_t worker_count);
+    ~job_system_t();
+
+    // Number of threads taking part in loops, the calling thread included.
+    size_t thread_count() const;
+
+    // Calls the function for consecutive ranges covering [0, count), in parallel. Every range but the last holds exactly
+    // grain indices, no matter how many threads there are. Returns once all ranges are done, rethrowing the first
+    // exception thrown by the function, if any. Must not be called from within a loop.
+    void parallel_for(size_t count, size_t grain, const range_function_t& function);
+
+private:
+    struct queue_t
+    {
+        std::mutex         mutex;
+        std::deque<size_t> ranges;
+    };
+
+    void worker_main(size_t thread_index);
+
+    // Runs a single range from the thread's own queue or one stolen from another. Returns false if none were left.
+    bool run_range(size_t thread_index);
+
+    std::vector<std::thread>              workers_m;
+    std::vector<std::unique_ptr<queue_t>> queues_m;
+
+    // Current loop. Workers are woken up by a change of generation.
+    std::mutex              mutex_m;
+    std::condition_variable wake_m;
+    std::condition_variable done_m;
+    uint64_t                generation_m{0};
+    bool                    stopping_m{false};
+
+    const range_function_t* function_m{nullptr};
+    size_t                  count_m{0};
+    size_t                  grain_m{1};
+    std::atomic<size_t>     remaining_m{0};
+    std::exception_ptr      exception_m;
+};
+
+} // namespace mau
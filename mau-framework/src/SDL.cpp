@@ -4,8 +4,14 @@
 
 namespace mau {
 
-sdl_context_t::sdl_context_t()
+sdl_context_t::sdl_context_t(bool headless)
 {
+    if(headless)
+    {
+        SDL_setenv("SDL_VIDEODRIVER", "offscreen", 1);
+        SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+    }
+
     if(SDL_Init(SDL_INIT_EVERYTHING) != 0)
     {
         throw exception_t{SDL_GetError()};
@@ -0,0 +1,35 @@
+#include "mau/containers/bit_grid.hpp"
+
+namespace mau {
+
+bit_grid_t::bit_grid_t(glm::ivec2 size) :
+    size_m(size), words_per_row_m((size.x + 63) / 64), words_m(words_per_row_m * size.y, 0)
+{
+}
+glm::ivec2 bit_grid_t::size() const
+{
+    return size_m;
+}
+void bit_grid_t::set(glm::ivec2 cell, bool value)
+{
+    if(!contains(cell))
+        return;
+
+    uint64_t& word = words_m[cell.y * words_per_row_m + (cell.x >> 6)];
+    uint64_t  bit  = 1ULL << (cell.x & 63);
+
+    if(value)
+        word |= bit;
+    else
+        word &= ~bit;
+}
+const uint64_t* bit_grid_t::row(int32_t y) const
+{
+    return &words_m[y * words_per_row_m];
+}
+size_t bit_grid_t::words_per_row() const
+{
+    return words_per_row_m;
+}
+
+} // namespace mau
@@ -16,5 +16,17 @@ uint32_t adler32(byte_t* data, size_t size)
 
     return (b << 16U) | a;
 }
+uint64_t fnv1a64(std::string_view data, uint64_t hash)
+{
+    static constexpr uint64_t prime_k = 0x100000001b3ULL;
+
+    for(char character: data)
+    {
+        hash ^= static_cast<byte_t>(character);
+        hash *= prime_k;
+    }
+
+    return hash;
+}
 
 } // namespace mau
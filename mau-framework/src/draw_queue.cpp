@@ -0,0 +1,142 @@
+#include "mau/rendering/draw_queue.hpp"
+
+#include "mau/profiling/profiler.hpp"
+#include "mau/rendering/renderer.hpp"
+
+#include <cassert>
+#include <cstring>
+
+namespace mau {
+
+uint32_t draw_ranges_t::push(span_t<int32_t> firsts, span_t<int32_t> counts)
+{
+    assert(firsts.size() == counts.size());
+
+    const uint32_t first = static_cast<uint32_t>(firsts_m.size());
+    firsts_m.insert(firsts_m.end(), firsts.begin(), firsts.end());
+    counts_m.insert(counts_m.end(), counts.begin(), counts.end());
+    return first;
+}
+span_t<int32_t> draw_ranges_t::firsts(uint32_t first, uint32_t count) const
+{
+    assert(first + count <= firsts_m.size());
+    return {firsts_m.data() + first, count};
+}
+span_t<int32_t> draw_ranges_t::counts(uint32_t first, uint32_t count) const
+{
+    assert(first + count <= counts_m.size());
+    return {counts_m.data() + first, count};
+}
+size_t draw_ranges_t::size() const
+{
+    return firsts_m.size();
+}
+void draw_ranges_t::clear()
+{
+    firsts_m.clear();
+    counts_m.clear();
+}
+
+draw_queue_t::draw_queue_t(renderer_t& renderer) : renderer_m(renderer)
+{
+}
+uint64_t draw_queue_t::sort_key(draw_pass_t pass, uint32_t shader_id, uint32_t texture_id, float depth)
+{
+    uint32_t bits = depth_bits(depth);
+    if(pass == draw_pass_t::translucent_k)
+        bits = ~bits;
+
+    return static_cast<uint64_t>(pass) << 60 | static_cast<uint64_t>(shader_id & 0xFFF) << 48 |
+           static_cast<uint64_t>(texture_id & 0xFFFF) << 32 | bits;
+}
+uint32_t draw_queue_t::depth_bits(float depth)
+{
+    // Bits of non-negative floats order the same way as the floats themselves.
+    uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    return bits;
+}
+void draw_queue_t::set_camera_position(glm::vec3 position)
+{
+    camera_position_m = position;
+}
+float draw_queue_t::depth(glm::vec3 position) const
+{
+    return glm::distance(camera_position_m, position);
+}
+uint32_t draw_queue_t::push_vertices(span_t<vertex_t> vertices)
+{
+    const uint32_t first = static_cast<uint32_t>(vertices_m.size());
+    vertices_m.insert(vertices_m.end(), vertices.begin(), vertices.end());
+    return first;
+}
+uint32_t draw_queue_t::push_ranges(span_t<int32_t> firsts, span_t<int32_t> counts)
+{
+    return ranges_m.push(firsts, counts);
+}
+void draw_queue_t::submit(draw_pass_t pass, float depth, draw_command_t command)
+{
+    const uint32_t texture_id = command.textures[0] ? command.textures[0]->gl_handle() : 0;
+
+    keys_m.push_back({sort_key(pass, command.shader->gl_handle(), texture_id, depth),
+                      static_cast<uint32_t>(commands_m.size())});
+    commands_m.push_back(std::move(command));
+}
+void draw_queue_t::execute()
+{
+    MAU_PROFILE_ZONE("draw_queue");
+
+    if(!vertices_m.empty())
+    {
+        if(!vertex_object_m)
+        {
+            vertex_object_m = vertex_object_t::create(
+                vertex_primitive_t::triangle_k, vertex_object_mode_t::stream_k, span_t<vertex_t>{});
+        }
+
+        renderer_m.upload_vertices(vertex_object_m, vertices_m);
+    }
+
+    radix_sort(keys_m, sort_scratch_m);
+
+    // Shaders skip uniforms which don't change between draws.
+    shader_t* shader = nullptr;
+
+    for(const auto& key: keys_m)
+    {
+        const draw_command_t& command = commands_m[key.index];
+
+        if(command.shader.get() != shader)
+        {
+            renderer_m.bind_shader(command.shader);
+            shader = command.shader.get();
+        }
+
+        for(uint32_t unit = 0; unit < command.textures.size(); ++unit)
+            renderer_m.bind_texture(command.textures[unit], unit);
+
+        shader->set_uniform_mat4(shader_uniform_t::model_matrix_k, command.model_matrix);
+
+        const vertex_object_handle_t& vertex_object = command.vertex_object ? command.vertex_object : vertex_object_m;
+
+        if(command.multi_draw)
+        {
+            renderer_m.render_vertex_object_ranges(vertex_object,
+                                                   ranges_m.firsts(command.first, command.count),
+                                                   ranges_m.counts(command.first, command.count));
+        }
+        else
+            renderer_m.render_vertex_object(vertex_object, command.first, command.count);
+    }
+
+    commands_m.clear();
+    keys_m.clear();
+    vertices_m.clear();
+    ranges_m.clear();
+}
+size_t draw_queue_t::size() const
+{
+    return commands_m.size();
+}
+
+} // namespace mau
@@ -0,0 +1,34 @@
+#include "mau/base/duration_statistics.hpp"
+
+#include "mau/base/timer.hpp"
+
+#include <algorithm>
+
+namespace mau {
+
+duration_statistics_t duration_statistics(std::vector<uint64_t>& microseconds)
+{
+    duration_statistics_t statistics;
+    statistics.count = microseconds.size();
+
+    if(microseconds.empty())
+        return statistics;
+
+    std::sort(microseconds.begin(), microseconds.end());
+
+    uint64_t total = 0;
+    for(auto duration: microseconds)
+        total += duration;
+
+    const size_t last = microseconds.size() - 1;
+
+    statistics.total         = total * timer_t::microseconds_to_seconds_k;
+    statistics.average       = statistics.total / microseconds.size();
+    statistics.median        = microseconds[last / 2] * timer_t::microseconds_to_seconds_k;
+    statistics.percentile_99 = microseconds[last * 99 / 100] * timer_t::microseconds_to_seconds_k;
+    statistics.maximum       = microseconds[last] * timer_t::microseconds_to_seconds_k;
+
+    return statistics;
+}
+
+} // namespace mau
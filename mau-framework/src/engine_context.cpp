@@ -5,10 +5,23 @@
 #include "mau/io/resource_cache.hpp"
 #include "mau/rendering/GL/common.hpp"
 
+#include <fmt/format.h>
+
+#include <algorithm>
+
 namespace mau {
 
-engine_context_t::engine_context_t(const char* name, log_t& log) : log_m(log), sdl_window_m(nullptr, SDL_DestroyWindow)
+engine_context_t::engine_context_t(const char* name, log_t& log, const engine_options_t& options) :
+    options_m(options),
+    log_m(log),
+    sdl_context_m(options.headless),
+    sdl_window_m(nullptr, SDL_DestroyWindow),
+    program_cache_m(options.shader_cache ? "shader_cache" : "", log),
+    frame_pacer_m(options.frame_pacer)
 {
+    profiler_t::set_thread_name("main");
+    profiler_m.set_enabled(!options_m.profile_path.empty());
+
     log.log("loading configuration");
     load_config();
 
@@ -17,7 +30,12 @@ engine_context_t::engine_context_t(const char* name, log_t& log) : log_m(log), s
 
     log.log("configuring main window");
     uint32_t flags = SDL_WINDOW_OPENGL;
-    if(config_m.fullscreen)
+    if(options_m.headless)
+    {
+        log.log("running headless");
+        flags |= SDL_WINDOW_HIDDEN;
+    }
+    else if(config_m.fullscreen)
     {
         flags |= SDL_WINDOW_FULLSCREEN_DESKTOP;
 
@@ -46,9 +64,15 @@ engine_context_t::engine_context_t(const char* name, log_t& log) : log_m(log), s
     audio_m          = std::make_unique<audio_t>(*this);
     state_manager_m  = std::make_unique<state_manager_t>(*this);
 
+    // The main thread takes part in parallel work too, so it doesn't need a worker of its own.
+    const size_t worker_count = std::max(std::thread::hardware_concurrency(), 1u) - 1;
+    log.log(fmt::format("starting {} worker threads", worker_count));
+    jobs_m = std::make_unique<job_system_t>(worker_count);
+
     sdl_keyboard_state_m = SDL_GetKeyboardState(nullptr);
 
-    SDL_SetRelativeMouseMode(SDL_TRUE);
+    if(!options_m.headless)
+        SDL_SetRelativeMouseMode(SDL_TRUE);
 }
 
 engine_context_t::~engine_context_t()
@@ -57,54 +81,97 @@ engine_context_t::~engine_context_t()
 
 void engine_context_t::runImpl()
 {
-    timer_t timer{};
-    double  accumulator{};
-
-    uint64_t frameTimeCurrent = timer.microseconds();
-    uint64_t frameTimeLast    = frameTimeCurrent;
-
-    static constexpr double fixed_framerate_k               = 60.0;
-    static constexpr double fixed_delta_time_microseconds_k = (1.0 / fixed_framerate_k) / timer_t::microseconds_to_seconds_k;
-    static constexpr double fixed_delta_time_seconds_k = fixed_delta_time_microseconds_k * timer_t::microseconds_to_seconds_k;
+    timer_t  timer{};
+    uint64_t frame_count{0};
+    bool     first_frame{true};
 
     while(!state_manager_m->empty())
     {
-        frameTimeCurrent              = timer.microseconds();
-        const uint64_t frameTimeDelta = frameTimeCurrent - frameTimeLast;
-        frameTimeLast                 = frameTimeCurrent;
+        profiler_m.begin_frame();
+        MAU_PROFILE_ZONE("frame");
 
-        if(frameTimeDelta)
-            framerate_array_m[framerate_tick_m] = 1000000.0 / frameTimeDelta;
-        framerate_tick_m                    = (framerate_tick_m + 1) % framerate_array_m.size();
+        if(options_m.frame_limit && frame_count++ == options_m.frame_limit)
+        {
+            const frame_statistics_t statistics = frame_pacer_m.statistics();
+            log_m.log(fmt::format("frame limit reached, frame times: average {:.3f} ms, 99th percentile {:.3f} ms, "
+                                  "maximum {:.3f} ms",
+                                  statistics.average * 1000.0,
+                                  statistics.percentile_99 * 1000.0,
+                                  statistics.maximum * 1000.0));
+
+            state_manager_m->clear();
+            break;
+        }
 
-        accumulator += frameTimeDelta;
+        const uint32_t steps = frame_pacer_m.advance(timer.microseconds());
+        for(uint32_t step = 0; step < steps; ++step)
+        {
+            MAU_PROFILE_ZONE("fixed_update");
+            state_manager_m->fixed_update(frame_pacer_m.fixed_delta_time());
+        }
 
-        while(accumulator >= fixed_delta_time_microseconds_k)
         {
-            state_manager_m->fixed_update((float)fixed_delta_time_seconds_k);
-            accumulator -= fixed_delta_time_microseconds_k;
+            MAU_PROFILE_ZONE("variable_update");
+            state_manager_m->variable_update(frame_pacer_m.frame_delta_time());
         }
 
-        const double variableDeltaTimeSeconds = frameTimeDelta * timer_t::microseconds_to_seconds_k;
-        state_manager_m->variable_update((float)variableDeltaTimeSeconds);
+        {
+            MAU_PROFILE_ZONE("render");
+            state_manager_m->render(frame_pacer_m.frame_delta_time());
+        }
 
-        state_manager_m->render((float)variableDeltaTimeSeconds);
+        {
+            MAU_PROFILE_ZONE("present");
+            renderer_m->present();
+        }
 
-        renderer_m->present();
+        if(first_frame)
+        {
+            first_frame = false;
+            log_m.log(fmt::format("first frame presented after {} ms, shader programs: {} loaded from cache, "
+                                  "{} compiled",
+                                  startup_timer_m.milliseconds(),
+                                  program_cache_m.hits(),
+                                  program_cache_m.misses()));
+        }
 
-        SDL_Event sdlEvent;
-        while(SDL_PollEvent(&sdlEvent))
         {
-            if(sdlEvent.type == SDL_QUIT)
+            MAU_PROFILE_ZONE("events");
+
+            SDL_Event sdlEvent;
+            while(SDL_PollEvent(&sdlEvent))
             {
-                state_manager_m->clear();
+                if(sdlEvent.type == SDL_QUIT)
+                {
+                    state_manager_m->clear();
+                }
+                state_manager_m->handle_event(sdlEvent);
             }
-            state_manager_m->handle_event(sdlEvent);
+
+            int32_t mouseDx{}, mouseDy{};
+            SDL_GetRelativeMouseState(&mouseDx, &mouseDy);
+            mouse_motion_m = glm::vec2{mouseDx, mouseDy};
+        }
+
+        // Vsync paces frames on its own, and unattended runs aren't paced at all.
+        if(!config_m.vsync && !options_m.unattended())
+        {
+            MAU_PROFILE_ZONE("frame_limit");
+            frame_pacer_m.limit_frame_rate(timer);
         }
+    }
 
-        int32_t mouseDx{}, mouseDy{};
-        SDL_GetRelativeMouseState(&mouseDx, &mouseDy);
-        mouse_motion_m = glm::vec2{mouseDx, mouseDy};
+    if(!options_m.profile_path.empty())
+    {
+        try
+        {
+            profiler_m.save_chrome_trace(options_m.profile_path);
+            log_m.log(fmt::format("saved profile into {}", options_m.profile_path));
+        }
+        catch(exception_t& e)
+        {
+            log_m.log(log_severity_t::error_k, e.what());
+        }
     }
 }
 
@@ -113,6 +180,11 @@ config_t& engine_context_t::config()
     return config_m;
 }
 
+const engine_options_t& engine_context_t::options() const
+{
+    return options_m;
+}
+
 log_t& engine_context_t::log()
 {
     return log_m;
@@ -138,6 +210,24 @@ resource_cache_t& engine_context_t::resource_cache()
     return *resource_cache_m.get();
 }
 
+profiler_t& engine_context_t::profiler()
+{
+    return profiler_m;
+}
+program_cache_t& engine_context_t::program_cache()
+{
+    return program_cache_m;
+}
+job_system_t& engine_context_t::jobs()
+{
+    return *jobs_m;
+}
+
+frame_pacer_t& engine_context_t::frame_pacer()
+{
+    return frame_pacer_m;
+}
+
 glm::ivec2 engine_context_t::viewport_size() const
 {
     return glm::ivec2{320, 240};
@@ -160,12 +250,8 @@ glm::vec2 engine_context_t::mouse_motion() const
 
 double engine_context_t::framerate() const
 {
-    double framerate{};
-
-    for(auto value: framerate_array_m)
-        framerate += value;
-
-    return framerate / framerate_array_m.size();
+    const double average = frame_pacer_m.statistics().average;
+    return average > 0.0 ? 1.0 / average : 0.0;
 }
 
 SDL_Window* engine_context_t::sdl_window()
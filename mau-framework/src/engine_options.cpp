@@ -0,0 +1,70 @@
+#include "mau/base/engine_options.hpp"
+
+#include <fmt/format.h>
+
+#include <charconv>
+#include <string_view>
+
+namespace mau {
+
+// Returns the argument following the option.
+static std::string_view option_value(int argc, const char* const* argv, int& i)
+{
+    if(i + 1 >= argc)
+        throw exception_t{fmt::format("missing value after {}", argv[i])};
+
+    return argv[++i];
+}
+// Parses the argument following the option as a number no lower than the minimum.
+template<typename T>
+static T option_number(int argc, const char* const* argv, int& i, const char* what, T minimum)
+{
+    const std::string_view value = option_value(argc, argv, i);
+
+    T          number{};
+    const auto result = std::from_chars(value.data(), value.data() + value.size(), number);
+    if(result.ec != std::errc{} || result.ptr != value.data() + value.size() || number < minimum)
+        throw exception_t{fmt::format("invalid {}: {}", what, value)};
+
+    return number;
+}
+engine_options_t engine_options_t::parse(int argc, const char* const* argv)
+{
+    engine_options_t options;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string_view option = argv[i];
+
+        if(option == "--headless")
+            options.headless = true;
+        else if(option == "--record")
+            options.record_path = option_value(argc, argv, i);
+        else if(option == "--timedemo")
+            options.timedemo_path = option_value(argc, argv, i);
+        else if(option == "--profile")
+            options.profile_path = option_value(argc, argv, i);
+        else if(option == "--no-shader-cache")
+            options.shader_cache = false;
+        else if(option == "--frames")
+            options.frame_limit = option_number<uint64_t>(argc, argv, i, "frame count", 0);
+        else if(option == "--tick-rate")
+            options.frame_pacer.fixed_rate = option_number(argc, argv, i, "tick rate", 1.0);
+        else if(option == "--max-substeps")
+            options.frame_pacer.max_substeps = option_number<uint32_t>(argc, argv, i, "substep count", 1);
+        else if(option == "--fps-limit")
+            options.frame_pacer.frame_rate_limit = option_number(argc, argv, i, "frame rate limit", 0.0);
+        else if(option == "--spin-limiter")
+            options.frame_pacer.limiter = frame_limiter_t::spin_k;
+        else
+            throw exception_t{fmt::format("unknown command line option: {}", option)};
+    }
+
+    return options;
+}
+bool engine_options_t::unattended() const
+{
+    return headless || !timedemo_path.empty();
+}
+
+} // namespace mau
@@ -0,0 +1,113 @@
+#include "mau/math/flow_field.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace mau {
+
+// Straight moves come first, so they're preferred over diagonal ones of the same length. Opposite moves are paired,
+// so flipping the lowest bit of an index reverses its move.
+static const std::array<glm::ivec2, 8> flow_field_moves_k = {
+    glm::ivec2{1, 0}, glm::ivec2{-1, 0}, glm::ivec2{0, 1}, glm::ivec2{0, -1},
+    glm::ivec2{1, 1}, glm::ivec2{-1, -1}, glm::ivec2{1, -1}, glm::ivec2{-1, 1}};
+
+// Move index of cells without a way forward.
+static constexpr uint8_t flow_field_no_move_k = 0xff;
+
+flow_field_t::flow_field_t(const bit_grid_t& blocked) :
+    blocked_m(&blocked),
+    distances_m(blocked.size().x * blocked.size().y, unreachable_k),
+    moves_m(blocked.size().x * blocked.size().y, flow_field_no_move_k),
+    open_moves_m(blocked.size().x * blocked.size().y, 0)
+{
+    frontier_m.reserve(distances_m.size());
+
+    // Blocked cells don't change, so the moves possible out of every cell are worked out once.
+    for(int32_t y = 0; y < blocked.size().y; ++y)
+    {
+        for(int32_t x = 0; x < blocked.size().x; ++x)
+        {
+            const glm::ivec2 cell{x, y};
+            uint8_t          open_moves = 0;
+
+            for(size_t i = 0; i < flow_field_moves_k.size(); ++i)
+            {
+                const glm::ivec2 move = flow_field_moves_k[i];
+                if(blocked.get(cell + move))
+                    continue;
+
+                // Diagonal moves need both adjacent straight cells open.
+                if(move.x != 0 && move.y != 0 && (blocked.get({x + move.x, y}) || blocked.get({x, y + move.y})))
+                    continue;
+
+                open_moves |= 1 << i;
+            }
+
+            open_moves_m[y * blocked.size().x + x] = open_moves;
+        }
+    }
+}
+void flow_field_t::compute(glm::ivec2 target)
+{
+    target_m = target;
+
+    std::fill(distances_m.begin(), distances_m.end(), unreachable_k);
+    std::fill(moves_m.begin(), moves_m.end(), flow_field_no_move_k);
+    frontier_m.clear();
+
+    if(blocked_m->get(target))
+        return;
+
+    const int32_t width = blocked_m->size().x;
+
+    distances_m[target.y * width + target.x] = 0;
+    frontier_m.push_back(target);
+
+    // The frontier vector doubles as the queue, cells are never removed from it.
+    for(size_t next = 0; next < frontier_m.size(); ++next)
+    {
+        const glm::ivec2 cell       = frontier_m[next];
+        const size_t     cell_index = cell.y * width + cell.x;
+        const uint32_t   distance   = distances_m[cell_index];
+
+        for(uint32_t open_moves = open_moves_m[cell_index], i = 0; open_moves; open_moves >>= 1, ++i)
+        {
+            if(!(open_moves & 1))
+                continue;
+
+            const glm::ivec2 neighbour = cell + flow_field_moves_k[i];
+            const size_t     index     = neighbour.y * width + neighbour.x;
+            if(distances_m[index] != unreachable_k)
+                continue;
+
+            // Search runs outwards from the target, so the way there is the opposite move.
+            distances_m[index] = distance + 1;
+            moves_m[index]     = static_cast<uint8_t>(i ^ 1);
+            frontier_m.push_back(neighbour);
+        }
+    }
+}
+glm::ivec2 flow_field_t::target() const
+{
+    return target_m;
+}
+uint32_t flow_field_t::distance(glm::ivec2 cell) const
+{
+    if(!blocked_m || !blocked_m->contains(cell))
+        return unreachable_k;
+
+    return distances_m[cell.y * blocked_m->size().x + cell.x];
+}
+glm::ivec2 flow_field_t::next_cell(glm::ivec2 cell) const
+{
+    if(!blocked_m || !blocked_m->contains(cell))
+        return cell;
+
+    const uint8_t move = moves_m[cell.y * blocked_m->size().x + cell.x];
+    if(move == flow_field_no_move_k)
+        return cell;
+
+    return cell + flow_field_moves_k[move];
+}
+
+} // namespace mau
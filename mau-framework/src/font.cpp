@@ -55,5 +55,44 @@ texture_handle_t font_t::texture()
 {
     return texture_m;
 }
+void font_t::append_glyph(std::vector<vertex_t>& vertices, glm::vec2 position, char character, glm::vec4 color) const
+{
+    const glm::ivec2 count = character_count;
+    const glm::vec2  size  = character_size;
+
+    const glm::vec2 uv_size = glm::vec2{1.0f / count.x, 1.0f / count.y};
+    const glm::vec2 uv_coord{(float)(character % count.x) / count.x, (float)(character / count.x) / count.y};
+
+    const int passes = shadow ? 2 : 1;
+
+    for(int pass = 0; pass < passes; ++pass)
+    {
+        glm::vec2 temp_position = position;
+        glm::vec4 color_top     = color;
+        glm::vec4 color_bottom  = gradient ? color_top * 0.675f : color_top;
+
+        if(shadow && pass == 0)
+        {
+            temp_position += glm::vec2{1, 1};
+            color_top    = glm::vec4(0, 0, 0, 1);
+            color_bottom = glm::vec4(0, 0, 0, 1);
+        }
+
+        vertices.emplace_back(glm::vec3{temp_position, 0.0f}, uv_coord, color_top);
+        vertices.emplace_back(glm::vec3{temp_position + glm::vec2{0.0f, size.y}, 0.0f},
+                              uv_coord + glm::vec2{0.0f, uv_size.y},
+                              color_bottom);
+        vertices.emplace_back(
+            glm::vec3{temp_position + glm::vec2{size.x, 0.0f}, 0.0f}, uv_coord + glm::vec2{uv_size.x, 0.0f}, color_top);
+        vertices.emplace_back(
+            glm::vec3{temp_position + glm::vec2{size.x, 0.0f}, 0.0f}, uv_coord + glm::vec2{uv_size.x, 0.0f}, color_top);
+        vertices.emplace_back(glm::vec3{temp_position + glm::vec2{0.0f, size.y}, 0.0f},
+                              uv_coord + glm::vec2{0.0f, uv_size.y},
+                              color_bottom);
+        vertices.emplace_back(glm::vec3{temp_position + glm::vec2{size.x, size.y}, 0.0f},
+                              uv_coord + glm::vec2{uv_size.x, uv_size.y},
+                              color_bottom);
+    }
+}
 
 } // namespace mau
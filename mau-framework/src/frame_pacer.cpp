@@ -0,0 +1,129 @@
+#include "mau/base/frame_pacer.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace mau {
+
+// Sleeps overshoot by up to about this much, so the last stretch before the deadline is spun through instead.
+static constexpr uint64_t sleep_margin_microseconds_k = 2000;
+
+frame_pacer_t::frame_pacer_t(const frame_pacer_settings_t& settings)
+{
+    set_settings(settings);
+}
+uint32_t frame_pacer_t::advance(uint64_t time_microseconds)
+{
+    frame_delta_m = started_m ? time_microseconds - frame_start_m : 0;
+    frame_start_m = time_microseconds;
+
+    if(started_m)
+    {
+        frame_times_m[frame_count_m % frame_times_m.size()] = frame_delta_m;
+        ++frame_count_m;
+    }
+
+    started_m = true;
+
+    if(settings_m.lockstep_steps > 0)
+    {
+        accumulator_m = 0;
+        return settings_m.lockstep_steps;
+    }
+
+    // Catching up on a hitch would only make the game jump ahead, so carry on as if just one step passed.
+    const auto hitch_threshold = static_cast<uint64_t>(settings_m.hitch_threshold / timer_t::microseconds_to_seconds_k);
+    if(frame_delta_m > hitch_threshold)
+    {
+        ++hitch_count_m;
+        accumulator_m = std::max(accumulator_m, fixed_step_microseconds_m);
+    }
+    else
+        accumulator_m += frame_delta_m;
+
+    uint32_t steps = static_cast<uint32_t>(accumulator_m / fixed_step_microseconds_m);
+    accumulator_m -= steps * fixed_step_microseconds_m;
+
+    if(steps > settings_m.max_substeps)
+    {
+        dropped_steps_m += steps - settings_m.max_substeps;
+        steps = settings_m.max_substeps;
+    }
+
+    return steps;
+}
+void frame_pacer_t::limit_frame_rate(const timer_t& timer) const
+{
+    if(settings_m.frame_rate_limit <= 0.0 || !started_m)
+        return;
+
+    const auto frame_microseconds = static_cast<uint64_t>(1000000.0 / settings_m.frame_rate_limit);
+    const auto deadline           = frame_start_m + frame_microseconds;
+
+    if(settings_m.limiter == frame_limiter_t::sleep_k)
+    {
+        const uint64_t now = timer.microseconds();
+        if(now + sleep_margin_microseconds_k < deadline)
+            std::this_thread::sleep_for(std::chrono::microseconds(deadline - now - sleep_margin_microseconds_k));
+    }
+
+    while(timer.microseconds() < deadline)
+    {
+    }
+}
+void frame_pacer_t::reset()
+{
+    accumulator_m = 0;
+    started_m     = false;
+}
+float frame_pacer_t::fixed_delta_time() const
+{
+    return static_cast<float>(fixed_step_microseconds_m * timer_t::microseconds_to_seconds_k);
+}
+float frame_pacer_t::frame_delta_time() const
+{
+    return static_cast<float>(frame_delta_m * timer_t::microseconds_to_seconds_k);
+}
+float frame_pacer_t::alpha() const
+{
+    return static_cast<float>(static_cast<double>(accumulator_m) / fixed_step_microseconds_m);
+}
+frame_statistics_t frame_pacer_t::statistics() const
+{
+    frame_statistics_t statistics;
+    statistics.hitch_count   = hitch_count_m;
+    statistics.dropped_steps = dropped_steps_m;
+
+    const size_t count = std::min(frame_count_m, frame_times_m.size());
+    if(count == 0)
+        return statistics;
+
+    decltype(frame_times_m) sorted;
+    std::copy_n(frame_times_m.begin(), count, sorted.begin());
+    std::sort(sorted.begin(), sorted.begin() + count);
+
+    uint64_t total = 0;
+    for(size_t i = 0; i < count; ++i)
+        total += sorted[i];
+
+    statistics.average       = total * timer_t::microseconds_to_seconds_k / count;
+    statistics.minimum       = sorted[0] * timer_t::microseconds_to_seconds_k;
+    statistics.maximum       = sorted[count - 1] * timer_t::microseconds_to_seconds_k;
+    statistics.percentile_99 = sorted[(count - 1) * 99 / 100] * timer_t::microseconds_to_seconds_k;
+
+    return statistics;
+}
+const frame_pacer_settings_t& frame_pacer_t::settings() const
+{
+    return settings_m;
+}
+void frame_pacer_t::set_settings(const frame_pacer_settings_t& settings)
+{
+    if(settings.fixed_rate <= 0.0)
+        throw exception_t{"fixed update rate must be positive"};
+
+    settings_m                = settings;
+    fixed_step_microseconds_m = static_cast<uint64_t>(1000000.0 / settings.fixed_rate);
+}
+
+} // namespace mau
@@ -0,0 +1,171 @@
+#include "mau/threading/job_system.hpp"
+
+#include "mau/profiling/profiler.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+
+namespace mau {
+
+job_system_t::job_system_t(size_t worker_count)
+{
+    for(size_t i = 0; i < worker_count + 1; ++i)
+        queues_m.push_back(std::make_unique<queue_t>());
+
+    // Thread index zero belongs to whoever calls parallel_for.
+    for(size_t i = 0; i < worker_count; ++i)
+        workers_m.emplace_back(&job_system_t::worker_main, this, i + 1);
+}
+job_system_t::~job_system_t()
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex_m};
+        stopping_m = true;
+    }
+    wake_m.notify_all();
+
+    for(auto& worker: workers_m)
+        worker.join();
+}
+size_t job_system_t::thread_count() const
+{
+    return queues_m.size();
+}
+void job_system_t::parallel_for(size_t count, size_t grain, const range_function_t& function)
+{
+    grain = std::max<size_t>(grain, 1);
+
+    const size_t range_count = (count + grain - 1) / grain;
+    if(range_count == 0)
+        return;
+
+    // Not worth waking anybody up for.
+    if(range_count == 1 || workers_m.empty())
+    {
+        for(size_t begin = 0; begin < count; begin += grain)
+            function(begin, std::min(begin + grain, count));
+        return;
+    }
+
+    // Workers still finishing off the previous loop may pick up ranges as soon as they're queued, so the loop has to be
+    // set up before.
+    {
+        std::lock_guard<std::mutex> lock{mutex_m};
+        function_m = &function;
+        count_m    = count;
+        grain_m    = grain;
+        remaining_m.store(range_count);
+        exception_m = nullptr;
+    }
+
+    // Deal consecutive ranges to each thread, so neighbouring data tends to stay on one thread unless stolen.
+    const size_t threads = thread_count();
+    for(size_t thread = 0; thread < threads; ++thread)
+    {
+        const size_t first = range_count * thread / threads;
+        const size_t last  = range_count * (thread + 1) / threads;
+
+        std::lock_guard<std::mutex> lock{queues_m[thread]->mutex};
+        for(size_t range = first; range < last; ++range)
+            queues_m[thread]->ranges.push_back(range);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{mutex_m};
+        ++generation_m;
+    }
+    wake_m.notify_all();
+
+    while(run_range(0))
+    {
+    }
+
+    // Stolen ranges may still be running on other threads.
+    std::unique_lock<std::mutex> lock{mutex_m};
+    done_m.wait(lock, [this] { return remaining_m.load() == 0; });
+
+    function_m = nullptr;
+
+    if(exception_m)
+        std::rethrow_exception(exception_m);
+}
+void job_system_t::worker_main(size_t thread_index)
+{
+    profiler_t::set_thread_name(fmt::format("worker {}", thread_index));
+
+    uint64_t generation = 0;
+
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock{mutex_m};
+            wake_m.wait(lock, [this, generation] { return stopping_m || generation_m != generation; });
+
+            if(stopping_m)
+                return;
+
+            generation = generation_m;
+        }
+
+        while(run_range(thread_index))
+        {
+        }
+    }
+}
+bool job_system_t::run_range(size_t thread_index)
+{
+    const size_t threads = thread_count();
+
+    size_t range  = 0;
+    bool   popped = false;
+
+    // Own queue is worked off from the front, others are stolen from at the back.
+    for(size_t i = 0; i < threads && !popped; ++i)
+    {
+        queue_t&                    queue = *queues_m[(thread_index + i) % threads];
+        std::lock_guard<std::mutex> lock{queue.mutex};
+
+        if(queue.ranges.empty())
+            continue;
+
+        if(i == 0)
+        {
+            range = queue.ranges.front();
+            queue.ranges.pop_front();
+        }
+        else
+        {
+            range = queue.ranges.back();
+            queue.ranges.pop_back();
+        }
+        popped = true;
+    }
+
+    if(!popped)
+        return false;
+
+    const size_t begin = range * grain_m;
+    const size_t end   = std::min(begin + grain_m, count_m);
+
+    try
+    {
+        (*function_m)(begin, end);
+    }
+    catch(...)
+    {
+        std::lock_guard<std::mutex> lock{mutex_m};
+        if(!exception_m)
+            exception_m = std::current_exception();
+    }
+
+    if(remaining_m.fetch_sub(1) == 1)
+    {
+        std::lock_guard<std::mutex> lock{mutex_m};
+        done_m.notify_all();
+    }
+
+    return true;
+}
+
+} // namespace mau
@@ -0,0 +1,156 @@
+#include "mau/math/potentially_visible_set.hpp"
+
+#include "mau/math/grid_raycast.hpp"
+#include "mau/threading/job_system.hpp"
+
+#include <glm/gtc/constants.hpp>
+
+#include <array>
+
+namespace mau {
+
+// Number of rays cast from each sample point.
+static constexpr int32_t pvs_ray_count_k = 256;
+
+// Sight lines grazing past walls often only clear them from near a corner, so rays are cast from cell corners as well
+// as centers. Corners are pulled in a little towards the cell they're cast from, so they stay within it.
+static constexpr float pvs_corner_inset_k = 1.0f / 64.0f;
+
+// Corners of the cell, offset from the cell itself.
+static constexpr std::array<glm::ivec2, 4> pvs_cell_corners_k{
+    glm::ivec2{0, 0}, glm::ivec2{1, 0}, glm::ivec2{0, 1}, glm::ivec2{1, 1}};
+
+// Open cells around a corner would all cast nearly the same rays from it, so only the first of them does.
+static bool owns_corner(const bit_grid_t& opaque, glm::ivec2 cell, glm::ivec2 corner)
+{
+    for(int32_t y = corner.y - 1; y <= corner.y; ++y)
+    {
+        for(int32_t x = corner.x - 1; x <= corner.x; ++x)
+        {
+            if(!opaque.get({x, y}))
+                return glm::ivec2{x, y} == cell;
+        }
+    }
+    return false;
+}
+
+potentially_visible_set_t::potentially_visible_set_t(const bit_grid_t& opaque,
+                                                     int32_t           region_size,
+                                                     job_system_t&     jobs) :
+    region_size_m(region_size),
+    region_count_m((opaque.size().x + region_size - 1) / region_size, (opaque.size().y + region_size - 1) / region_size)
+{
+    const int32_t region_total = region_count_m.x * region_count_m.y;
+
+    // Dense visibility matrix first, compacted into lists once it's complete.
+    std::vector<uint8_t> visible(region_total * region_total, 0);
+
+    std::array<glm::vec2, pvs_ray_count_k> directions;
+    for(int32_t i = 0; i < pvs_ray_count_k; ++i)
+    {
+        const float angle = glm::two_pi<float>() * i / pvs_ray_count_k;
+        directions[i]     = glm::vec2{std::cos(angle), std::sin(angle)};
+    }
+
+    // Regions are sampled in parallel. Every region only writes its own row, so the outcome doesn't depend on threads.
+    jobs.parallel_for(region_total, 1, [&](size_t begin, size_t end) {
+        for(size_t source = begin; source < end; ++source)
+        {
+            uint8_t* row = &visible[source * region_total];
+            row[source]  = 1;
+
+            const auto cast_fan = [&](glm::vec2 origin) {
+                for(const auto& direction: directions)
+                {
+                    math::grid_raycast(opaque, origin, direction, [&](glm::ivec2 cell) {
+                        const int32_t target = region_index(cell);
+                        if(target >= 0)
+                            row[target] = 1;
+                        return true;
+                    });
+                }
+            };
+
+            const glm::ivec2 first = region_position(static_cast<int32_t>(source)) * region_size_m;
+            const glm::ivec2 last  = glm::min(first + region_size_m, opaque.size());
+
+            for(int32_t y = first.y; y < last.y; ++y)
+            {
+                for(int32_t x = first.x; x < last.x; ++x)
+                {
+                    if(opaque.get({x, y}))
+                        continue;
+
+                    const glm::vec2 center = glm::vec2{x, y} + 0.5f;
+                    cast_fan(center);
+
+                    for(const auto& offset: pvs_cell_corners_k)
+                    {
+                        const glm::ivec2 corner = glm::ivec2{x, y} + offset;
+                        if(owns_corner(opaque, {x, y}, corner))
+                            cast_fan(glm::vec2{corner} + (center - glm::vec2{corner}) * (2.0f * pvs_corner_inset_k));
+                    }
+                }
+            }
+        }
+    });
+
+    // Visibility is symmetric, but sampling isn't - merge both directions to stay conservative.
+    for(int32_t a = 0; a < region_total; ++a)
+    {
+        for(int32_t b = a + 1; b < region_total; ++b)
+        {
+            const uint8_t either = visible[a * region_total + b] | visible[b * region_total + a];
+
+            visible[a * region_total + b] = either;
+            visible[b * region_total + a] = either;
+        }
+    }
+
+    visible_offsets_m.reserve(region_total + 1);
+    for(int32_t a = 0; a < region_total; ++a)
+    {
+        visible_offsets_m.push_back(static_cast<uint32_t>(visible_regions_m.size()));
+
+        for(int32_t b = 0; b < region_total; ++b)
+        {
+            if(visible[a * region_total + b] || a == b)
+                visible_regions_m.push_back(b);
+        }
+    }
+    visible_offsets_m.push_back(static_cast<uint32_t>(visible_regions_m.size()));
+}
+int32_t potentially_visible_set_t::region_size() const
+{
+    return region_size_m;
+}
+glm::ivec2 potentially_visible_set_t::region_count() const
+{
+    return region_count_m;
+}
+int32_t potentially_visible_set_t::region_index(glm::ivec2 cell) const
+{
+    if(cell.x < 0 || cell.y < 0)
+        return -1;
+
+    const glm::ivec2 region = cell / region_size_m;
+    if(region.x >= region_count_m.x || region.y >= region_count_m.y)
+        return -1;
+
+    return region.y * region_count_m.x + region.x;
+}
+glm::ivec2 potentially_visible_set_t::region_position(int32_t region_index) const
+{
+    return {region_index % region_count_m.x, region_index / region_count_m.x};
+}
+span_t<uint32_t> potentially_visible_set_t::visible_regions(int32_t region_index) const
+{
+    if(region_index < 0 || region_index >= static_cast<int32_t>(visible_offsets_m.size()) - 1)
+        return {};
+
+    const uint32_t begin = visible_offsets_m[region_index];
+    const uint32_t end   = visible_offsets_m[region_index + 1];
+    return span_t<uint32_t>{visible_regions_m.data() + begin, end - begin};
+}
+
+} // namespace mau
@@ -0,0 +1,203 @@
+#include "mau/profiling/profiler.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string_view>
+
+namespace mau {
+
+static std::atomic<profiler_t*> active_profiler{nullptr};
+static std::atomic<uint64_t>    next_profiler_id{1};
+
+// Buffer of the calling thread, and the profiler it belongs to.
+static thread_local void*       thread_buffer_pointer{nullptr};
+static thread_local uint64_t    thread_buffer_profiler{0};
+static thread_local std::string thread_name{"thread"};
+
+static uint64_t profiler_now()
+{
+    const auto time = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count());
+}
+profiler_t::profiler_t() : id_m(next_profiler_id++), epoch_m(profiler_now())
+{
+    active_profiler = this;
+}
+profiler_t::~profiler_t()
+{
+    profiler_t* self = this;
+    active_profiler.compare_exchange_strong(self, nullptr);
+}
+profiler_t* profiler_t::active()
+{
+    return active_profiler.load(std::memory_order_relaxed);
+}
+void profiler_t::set_thread_name(std::string name)
+{
+    thread_name = std::move(name);
+}
+void profiler_t::set_enabled(bool enabled)
+{
+    enabled_m = enabled;
+}
+bool profiler_t::enabled() const
+{
+    return enabled_m.load(std::memory_order_relaxed);
+}
+void profiler_t::begin_frame()
+{
+    const uint64_t now = profiler_now();
+
+    if(enabled() && frame_start_m)
+        summarize(frame_start_m, now);
+    else
+        frame_summary_m.clear();
+
+    frame_start_m = now;
+}
+const std::vector<profile_zone_summary_t>& profiler_t::frame_summary() const
+{
+    return frame_summary_m;
+}
+void profiler_t::save_chrome_trace(const std::string& path) const
+{
+    std::fstream stream{path, std::ios_base::out};
+    if(!stream)
+        throw exception_t{fmt::format("unable to open {} for writing", path)};
+
+    std::lock_guard<std::mutex> lock{buffers_mutex_m};
+
+    stream << "{\"traceEvents\":[\n";
+
+    bool first = true;
+    for(const auto& buffer: buffers_m)
+    {
+        stream << fmt::format("{}{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},"
+                              "\"args\":{{\"name\":\"{}\"}}}}",
+                              first ? "" : ",\n",
+                              buffer->thread_id,
+                              buffer->name);
+        first = false;
+
+        const uint64_t written = buffer->written.load(std::memory_order_acquire);
+        for(uint64_t i = written - std::min<uint64_t>(written, ring_capacity_k); i < written; ++i)
+        {
+            const event_t& event = buffer->events[i % ring_capacity_k];
+
+            // Timestamps are in microseconds, relative to the profiler's creation.
+            stream << fmt::format(",\n{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},"
+                                  "\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                                  event.name,
+                                  buffer->thread_id,
+                                  (event.begin - epoch_m) / 1000.0,
+                                  (event.end - event.begin) / 1000.0);
+        }
+    }
+
+    stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    if(!stream)
+        throw exception_t{fmt::format("error while writing trace {}", path)};
+}
+uint64_t profiler_t::enter_zone()
+{
+    ++thread_buffer().depth;
+    return profiler_now();
+}
+void profiler_t::leave_zone(const char* name, uint64_t begin)
+{
+    const uint64_t end = profiler_now();
+
+    thread_buffer_t& buffer = thread_buffer();
+    --buffer.depth;
+
+    // Only this thread writes into the buffer, so the count can't change under its hands.
+    const uint64_t written = buffer.written.load(std::memory_order_relaxed);
+
+    buffer.events[written % ring_capacity_k] = event_t{name, begin, end, buffer.depth};
+    buffer.written.store(written + 1, std::memory_order_release);
+}
+profiler_t::thread_buffer_t& profiler_t::thread_buffer()
+{
+    if(thread_buffer_profiler == id_m)
+        return *static_cast<thread_buffer_t*>(thread_buffer_pointer);
+
+    auto buffer = std::make_unique<thread_buffer_t>();
+    buffer->name = thread_name;
+    buffer->events.resize(ring_capacity_k);
+
+    std::lock_guard<std::mutex> lock{buffers_mutex_m};
+    buffer->thread_id = static_cast<uint32_t>(buffers_m.size());
+    buffers_m.push_back(std::move(buffer));
+
+    thread_buffer_pointer  = buffers_m.back().get();
+    thread_buffer_profiler = id_m;
+    return *buffers_m.back();
+}
+void profiler_t::summarize(uint64_t begin, uint64_t end)
+{
+    frame_summary_m.clear();
+
+    // First entry time of every zone, for ordering.
+    std::vector<uint64_t> first_entries;
+
+    std::lock_guard<std::mutex> lock{buffers_mutex_m};
+    for(const auto& buffer: buffers_m)
+    {
+        // Zones are recorded as they end, so walk back from the latest until they end before the frame.
+        const uint64_t written = buffer->written.load(std::memory_order_acquire);
+        const uint64_t oldest  = written - std::min<uint64_t>(written, ring_capacity_k);
+
+        for(uint64_t i = written; i > oldest; --i)
+        {
+            const event_t& event = buffer->events[(i - 1) % ring_capacity_k];
+            if(event.end < begin)
+                break;
+            if(event.begin < begin || event.end > end)
+                continue;
+
+            auto summary = std::find_if(frame_summary_m.begin(), frame_summary_m.end(), [&](const auto& summary) {
+                return std::string_view{summary.name} == event.name;
+            });
+
+            if(summary == frame_summary_m.end())
+            {
+                frame_summary_m.push_back({event.name, event.depth, 0, 0.0});
+                first_entries.push_back(event.begin);
+                summary = frame_summary_m.end() - 1;
+            }
+
+            uint64_t& first_entry = first_entries[summary - frame_summary_m.begin()];
+            if(event.begin < first_entry)
+            {
+                first_entry    = event.begin;
+                summary->depth = event.depth;
+            }
+
+            ++summary->calls;
+            summary->seconds += (event.end - event.begin) / 1e9;
+        }
+    }
+
+    // Order by first entry, which puts zones after the zones they're nested in.
+    std::vector<size_t> order(frame_summary_m.size());
+    for(size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        if(first_entries[a] != first_entries[b])
+            return first_entries[a] < first_entries[b];
+        return frame_summary_m[a].depth < frame_summary_m[b].depth;
+    });
+
+    std::vector<profile_zone_summary_t> sorted;
+    sorted.reserve(order.size());
+    for(auto i: order)
+        sorted.push_back(frame_summary_m[i]);
+
+    frame_summary_m = std::move(sorted);
+}
+
+} // namespace mau
@@ -0,0 +1,194 @@
+#include "mau/rendering/program_cache.hpp"
+
+#include "mau/base/log.hpp"
+#include "mau/math/checksum.hpp"
+#include "mau/rendering/GL/common.hpp"
+
+#include <fmt/format.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace mau {
+
+static constexpr uint32_t program_binary_magic_k   = 0x4752504d; // "MPRG"
+static constexpr uint32_t program_binary_version_k = 1;
+
+struct program_binary_header_t
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint32_t format;
+    uint32_t size;
+};
+
+static std::string_view gl_string(GLenum name)
+{
+    const char* string = reinterpret_cast<const char*>(glGetString(name));
+    return string ? string : "";
+}
+// Program binaries are core since GL 4.1, and an extension before.
+static bool program_binaries_supported()
+{
+    if(!glGetProgramBinary || !glProgramBinary || !glProgramParameteri)
+        return false;
+
+    int32_t major{0}, minor{0};
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+
+    bool supported = major > 4 || (major == 4 && minor >= 1);
+
+    int32_t extension_count{0};
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extension_count);
+    for(int32_t i = 0; i < extension_count && !supported; ++i)
+    {
+        const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+        supported             = extension && std::strcmp(extension, "GL_ARB_get_program_binary") == 0;
+    }
+
+    if(!supported)
+        return false;
+
+    int32_t format_count{0};
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+    return format_count > 0;
+}
+program_cache_t::program_cache_t(std::string directory, log_t& log) : directory_m(std::move(directory)), log_m(log)
+{
+}
+bool program_cache_t::enabled()
+{
+    if(!initialized_m)
+    {
+        initialized_m = true;
+
+        if(directory_m.empty())
+            return false;
+
+        supported_m = program_binaries_supported();
+        if(!supported_m)
+        {
+            log_m.log(log_severity_t::warning_k, "program binaries not supported, shaders will not be cached");
+            return false;
+        }
+
+        // Binaries are only good for the driver which produced them.
+        driver_hash_m = fnv1a64(gl_string(GL_VENDOR));
+        driver_hash_m = fnv1a64(gl_string(GL_RENDERER), driver_hash_m);
+        driver_hash_m = fnv1a64(gl_string(GL_VERSION), driver_hash_m);
+    }
+
+    return supported_m;
+}
+bool program_cache_t::load(gl_handle_t program, std::string_view vertex_source, std::string_view fragment_source)
+{
+    // Programs linked from source count as misses even with the cache disabled, so startup reports what was compiled.
+    if(!enabled())
+    {
+        ++misses_m;
+        return false;
+    }
+
+    const uint64_t    key  = program_key(vertex_source, fragment_source);
+    const std::string path = program_path(key);
+
+    program_binary_header_t header{};
+    std::vector<char>       binary;
+
+    std::error_code error;
+    const uintmax_t file_size = std::filesystem::file_size(path, error);
+
+    // A size beyond the end of the file means the header is corrupt, which would make for a huge allocation.
+    std::fstream stream{path, std::ios_base::in | std::ios_base::binary};
+    if(!error && stream && stream.read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+       header.magic == program_binary_magic_k && header.version == program_binary_version_k && header.key == key &&
+       header.size <= file_size - sizeof(header))
+    {
+        binary.resize(header.size);
+        if(!stream.read(binary.data(), binary.size()))
+            binary.clear();
+    }
+
+    if(binary.empty())
+    {
+        ++misses_m;
+        return false;
+    }
+
+    // Drivers reject binaries they can't use anymore, such as after an update, in which case they're replaced once
+    // the program is linked from source.
+    glProgramBinary(program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+    int32_t success{false};
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if(!success)
+    {
+        ++misses_m;
+        return false;
+    }
+
+    ++hits_m;
+    return true;
+}
+void program_cache_t::store(gl_handle_t program, std::string_view vertex_source, std::string_view fragment_source)
+{
+    if(!enabled())
+        return;
+
+    int32_t size{0};
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &size);
+    if(size <= 0)
+        return;
+
+    std::vector<char> binary(size);
+    GLenum            format{0};
+    GLsizei           length{0};
+    glGetProgramBinary(program, size, &length, &format, binary.data());
+
+    const uint64_t                key = program_key(vertex_source, fragment_source);
+    const program_binary_header_t header{
+        program_binary_magic_k, program_binary_version_k, key, format, static_cast<uint32_t>(length)};
+
+    std::error_code error;
+    std::filesystem::create_directories(directory_m, error);
+
+    const std::string path = program_path(key);
+
+    std::fstream stream{path, std::ios_base::out | std::ios_base::binary};
+    if(stream)
+    {
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        stream.write(binary.data(), length);
+    }
+
+    if(!stream)
+        log_m.log(log_severity_t::warning_k, fmt::format("unable to write program binary into {}", path));
+}
+uint32_t program_cache_t::hits() const
+{
+    return hits_m;
+}
+uint32_t program_cache_t::misses() const
+{
+    return misses_m;
+}
+uint64_t program_cache_t::program_key(std::string_view vertex_source, std::string_view fragment_source) const
+{
+    // Lengths go in too, so moving text from one source to the other changes the key.
+    const uint64_t lengths[] = {vertex_source.size(), fragment_source.size()};
+
+    uint64_t key = fnv1a64(std::string_view{reinterpret_cast<const char*>(lengths), sizeof(lengths)}, driver_hash_m);
+    key          = fnv1a64(vertex_source, key);
+    key          = fnv1a64(fragment_source, key);
+    return key;
+}
+std::string program_cache_t::program_path(uint64_t key) const
+{
+    return fmt::format("{}/{:016x}.bin", directory_m, key);
+}
+
+} // namespace mau
@@ -0,0 +1,53 @@
+#include "mau/containers/radix_sort.hpp"
+
+#include <array>
+
+namespace mau {
+
+static constexpr uint32_t radix_bits_k   = 8;
+static constexpr uint32_t radix_size_k   = 1U << radix_bits_k;
+static constexpr uint32_t radix_passes_k = 64 / radix_bits_k;
+
+static uint32_t radix_digit(uint64_t key, uint32_t pass)
+{
+    return static_cast<uint32_t>(key >> (pass * radix_bits_k)) & (radix_size_k - 1);
+}
+void radix_sort(std::vector<radix_sort_entry_t>& entries, std::vector<radix_sort_entry_t>& scratch)
+{
+    if(entries.empty())
+        return;
+
+    scratch.resize(entries.size());
+
+    // Histograms of all passes are gathered in a single read over the entries.
+    std::array<std::array<uint32_t, radix_size_k>, radix_passes_k> counts{};
+    for(const auto& entry: entries)
+    {
+        for(uint32_t pass = 0; pass < radix_passes_k; ++pass)
+            ++counts[pass][radix_digit(entry.key, pass)];
+    }
+
+    for(uint32_t pass = 0; pass < radix_passes_k; ++pass)
+    {
+        auto& offsets = counts[pass];
+
+        // All entries share the digit, so the pass wouldn't move anything.
+        if(offsets[radix_digit(entries.front().key, pass)] == entries.size())
+            continue;
+
+        uint32_t offset = 0;
+        for(auto& count: offsets)
+        {
+            const uint32_t digit_count = count;
+            count = offset;
+            offset += digit_count;
+        }
+
+        for(const auto& entry: entries)
+            scratch[offsets[radix_digit(entry.key, pass)]++] = entry;
+
+        entries.swap(scratch);
+    }
+}
+
+} // namespace mau
@@ -9,6 +9,10 @@ render_target_handle_t render_target_t::create(glm::ivec2 size, uint32_t color_a
 }
 render_target_t::render_target_t(glm::ivec2 size, uint32_t color_attachment_count) : size_m(size)
 {
+    // The renderer keeps track of the bound framebuffer, so put it back afterwards.
+    GLint previous_framebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous_framebuffer);
+
     glGenFramebuffers(1, &gl_handle_m);
     glBindFramebuffer(GL_FRAMEBUFFER, gl_handle_m);
 
@@ -29,7 +33,7 @@ render_target_t::render_target_t(glm::ivec2 size, uint32_t color_attachment_coun
     glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, size.x, size.y);
     glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, rbo_handle_m);
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previous_framebuffer));
 }
 render_target_t::~render_target_t()
 {
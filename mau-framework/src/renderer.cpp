@@ -6,6 +6,14 @@
 #include "mau/math/algorithms.hpp"
 #include "mau/rendering/GL/common.hpp"
 
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
 // OpenGL diagnostics callback.
 void gl_message_callback(GLenum        source,
                          GLenum        type,
@@ -45,9 +53,10 @@ renderer_t::renderer_t(engine_context_t& engine) :
     glDebugMessageCallback(gl_message_callback, &engine);
 
     // Set VSync setting.
-    SDL_GL_SetSwapInterval(engine.config().vsync ? 1 : 0);
+    restore_vsync();
 
-    glViewport(0, 0, engine_m.resolution().x, engine_m.resolution().y);
+    viewport_m = {0, 0, engine_m.resolution()};
+    glViewport(viewport_m.x, viewport_m.y, viewport_m.z, viewport_m.w);
 
     glEnable(GL_CULL_FACE);
     glEnable(GL_DEPTH_TEST);
@@ -56,17 +65,37 @@ renderer_t::renderer_t(engine_context_t& engine) :
     glEnable(GL_PROGRAM_POINT_SIZE);
     glDepthMask(GL_TRUE);
 
+    // Matches the initial shadowed state.
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     batch_vertex_object_m =
         vertex_object_t::create(vertex_primitive_t::triangle_k, vertex_object_mode_t::dynamic_k, span_t<vertex_t>{});
 
+    // Reaches past the corners of NDC, which get clipped, so texture coordinates are 0 to 1 on screen. Unlike two
+    // triangles, there's no diagonal seam where fragments along it get shaded twice.
+    std::array<vertex_t, 3> fullscreen_triangle{vertex_t{glm::vec3{-1, -1, 0}, glm::vec2{0, 0}},
+                                                vertex_t{glm::vec3{3, -1, 0}, glm::vec2{2, 0}},
+                                                vertex_t{glm::vec3{-1, 3, 0}, glm::vec2{0, 2}}};
+    fullscreen_triangle_m = vertex_object_t::create(
+        vertex_primitive_t::triangle_k, vertex_object_mode_t::static_k, span_t<vertex_t>{fullscreen_triangle});
+
+    // Stays bound to its binding point, which shaders point their pass constants block at.
+    glGenBuffers(1, &pass_constants_buffer_m);
+    glBindBuffer(GL_UNIFORM_BUFFER, pass_constants_buffer_m);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(pass_constants_t), nullptr, GL_DYNAMIC_DRAW);
+    glBindBufferBase(GL_UNIFORM_BUFFER, pass_constants_binding_k, pass_constants_buffer_m);
+
     passthrough_shader_m = engine_m.resource_cache().resource<shader_t>("passthrough.sha");
 }
 
 renderer_t::~renderer_t()
 {
+    for(auto& frame: gpu_query_frames_m)
+        glDeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+
+    glDeleteBuffers(1, &pass_constants_buffer_m);
+
     glDisable(GL_DEBUG_OUTPUT);
 }
 
@@ -89,29 +118,64 @@ void renderer_t::clear_color(glm::vec4 color)
 
 void renderer_t::set_depth_test(depth_test_t depth_test)
 {
+    if(depth_test == depth_test_m)
+        return;
+
     if(depth_test == depth_test_t::enabled_k)
         glEnable(GL_DEPTH_TEST);
     else
         glDisable(GL_DEPTH_TEST);
+
+    depth_test_m = depth_test;
 }
 
 depth_test_t renderer_t::depth_test()
 {
-    return glIsEnabled(GL_DEPTH_TEST) ? depth_test_t::enabled_k : depth_test_t::disabled_k;
+    return depth_test_m;
 }
 
 void renderer_t::set_fill_mode(fill_mode_t fill_mode)
 {
+    if(fill_mode == fill_mode_m)
+        return;
+
     GLenum gl_mode = fill_mode == fill_mode_t::fill_k ? GL_FILL : GL_LINE;
     glPolygonMode(GL_FRONT_AND_BACK, gl_mode);
+
+    fill_mode_m = fill_mode;
 }
 
 fill_mode_t renderer_t::fill_mode()
 {
-    GLint previous[2];
-    glGetIntegerv(GL_POLYGON_MODE, previous);
+    return fill_mode_m;
+}
+
+void renderer_t::set_blend_mode(blend_mode_t blend_mode)
+{
+    if(blend_mode == blend_mode_m)
+        return;
+
+    if(blend_mode == blend_mode_t::disabled_k)
+    {
+        glDisable(GL_BLEND);
+    }
+    else
+    {
+        if(blend_mode_m == blend_mode_t::disabled_k)
+            glEnable(GL_BLEND);
+
+        if(blend_mode == blend_mode_t::alpha_k)
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        else
+            glBlendFunc(GL_ONE, GL_ONE);
+    }
 
-    return previous[1] == GL_FILL ? fill_mode_t::fill_k : fill_mode_t::wireframe_k;
+    blend_mode_m = blend_mode;
+}
+
+blend_mode_t renderer_t::blend_mode() const
+{
+    return blend_mode_m;
 }
 
 void renderer_t::set_vsync(bool enabled)
@@ -121,39 +185,131 @@ void renderer_t::set_vsync(bool enabled)
 
 void renderer_t::restore_vsync()
 {
-    SDL_GL_SetSwapInterval(engine_m.config().vsync ? 1 : 0);
+    // Unattended runs go as fast as they can.
+    SDL_GL_SetSwapInterval(engine_m.config().vsync && !engine_m.options().unattended() ? 1 : 0);
 }
 
 void renderer_t::bind_shader(shader_handle_t shader)
 {
+    if(shader == bound_shader_m)
+        return;
+
     glUseProgram(shader->gl_handle());
+    ++counters_m.shader_switches;
 
     shader->bind_texture_units();
+    bound_shader_m = std::move(shader);
 }
 
 void renderer_t::bind_render_target(render_target_handle_t render_target)
 {
-    glBindFramebuffer(GL_FRAMEBUFFER, render_target->gl_handle());
-
-    auto size = render_target->size();
-    glViewport(0, 0, size.x, size.y);
+    set_viewport({0, 0, render_target->size()});
+    bind_framebuffer(std::move(render_target));
 }
 
 void renderer_t::bind_texture(texture_handle_t texture, uint32_t texture_unit)
 {
-    glActiveTexture(GL_TEXTURE0 + texture_unit);
+    if(texture_unit >= texture_unit_count_k)
+        throw renderer_exception_t{fmt::format("texture unit {} out of range", texture_unit)};
+
+    if(texture == bound_textures_m[texture_unit])
+        return;
+
+    if(texture_unit != active_texture_unit_m)
+    {
+        glActiveTexture(GL_TEXTURE0 + texture_unit);
+        active_texture_unit_m = texture_unit;
+    }
+
     glBindTexture(GL_TEXTURE_2D, texture ? texture->gl_handle() : 0);
+    ++counters_m.texture_binds;
+
+    bound_textures_m[texture_unit] = std::move(texture);
 }
 
 void renderer_t::clear_render_target()
 {
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    glViewport(0, 0, engine_m.resolution().x, engine_m.resolution().y);
+    bind_framebuffer(nullptr);
+    set_viewport({0, 0, engine_m.resolution()});
+}
+
+void renderer_t::set_pass_constants(const pass_constants_t& constants)
+{
+    if(pass_constants_m && std::memcmp(&*pass_constants_m, &constants, sizeof(constants)) == 0)
+        return;
+
+    glBindBuffer(GL_UNIFORM_BUFFER, pass_constants_buffer_m);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(constants), &constants);
+    pass_constants_m = constants;
+
+    ++counters_m.buffer_uploads;
+    counters_m.uploaded_bytes += sizeof(constants);
+}
+
+void renderer_t::begin_render_pass(const render_pass_t& pass)
+{
+    if(pass.target)
+    {
+        bind_render_target(pass.target);
+    }
+    else if(pass.mode == framebuffer_render_mode_t::perform_aspect_correction_k)
+    {
+        // Letterbox by narrowing the viewport, rather than the geometry, so passes draw the same triangle either way.
+        const glm::ivec2 resolution    = engine_m.resolution();
+        const float      target_aspect = engine_m.viewport_size().x / (float)engine_m.viewport_size().y;
+        const int32_t    width         = static_cast<int32_t>(std::round(resolution.y * target_aspect));
+
+        bind_framebuffer(nullptr);
+        set_viewport({(resolution.x - width) / 2, 0, width, resolution.y});
+    }
+    else
+    {
+        clear_render_target();
+    }
+
+    // Clearing ignores the viewport, so letterboxed passes clear the bars along with the rest.
+    GLbitfield clear_mask = 0;
+    if(pass.clear_color)
+    {
+        glClearColor(pass.clear_color->r, pass.clear_color->g, pass.clear_color->b, pass.clear_color->a);
+        clear_mask |= GL_COLOR_BUFFER_BIT;
+    }
+    if(pass.clear_depth)
+        clear_mask |= GL_DEPTH_BUFFER_BIT;
+    if(clear_mask)
+        glClear(clear_mask);
+
+    if(pass.shader)
+        bind_shader(pass.shader);
+
+    for(size_t i = 0; i < pass.inputs.size() && pass.inputs[i]; ++i)
+        bind_texture(pass.inputs[i], static_cast<uint32_t>(i));
+}
+
+void renderer_t::draw_fullscreen_pass(const render_pass_t& pass)
+{
+    begin_render_pass(pass);
+    render_fullscreen_triangle();
 }
 
 void renderer_t::present()
 {
     SDL_GL_SwapWindow(engine_m.sdl_window());
+
+    frame_counters_m = counters_m;
+    counters_m       = {};
+
+    gpu_query_frame_t& frame = gpu_query_frames_m[gpu_query_frame_m];
+    frame.pending            = frame.used > 0;
+
+    // Read frames oldest first, stopping at one still running, so the times shown never go back to older ones.
+    for(size_t i = 1; i <= gpu_query_frames_m.size(); ++i)
+    {
+        if(!collect_gpu_pass_times(gpu_query_frames_m[(gpu_query_frame_m + i) % gpu_query_frames_m.size()]))
+            break;
+    }
+
+    gpu_query_frame_m = (gpu_query_frame_m + 1) % gpu_query_frames_m.size();
 }
 
 void renderer_t::render_vertex_object(vertex_object_handle_t vertex_object)
@@ -161,6 +317,150 @@ void renderer_t::render_vertex_object(vertex_object_handle_t vertex_object)
     glBindVertexArray(vertex_object->gl_handle());
     glDrawArrays(
         vertex_object_t::gl_primitive(vertex_object->primitive()), 0, static_cast<GLsizei>(vertex_object->vertex_count()));
+    ++counters_m.draw_calls;
+}
+
+void renderer_t::render_vertex_object(vertex_object_handle_t vertex_object, size_t first, size_t count)
+{
+    glBindVertexArray(vertex_object->gl_handle());
+    glDrawArrays(vertex_object_t::gl_primitive(vertex_object->primitive()),
+                 static_cast<GLint>(first),
+                 static_cast<GLsizei>(count));
+    ++counters_m.draw_calls;
+}
+
+void renderer_t::render_vertex_object_ranges(vertex_object_handle_t vertex_object,
+                                             span_t<int32_t>        firsts,
+                                             span_t<int32_t>        counts)
+{
+    assert(firsts.size() == counts.size());
+
+    glBindVertexArray(vertex_object->gl_handle());
+    glMultiDrawArrays(vertex_object_t::gl_primitive(vertex_object->primitive()),
+                      firsts.data(),
+                      counts.data(),
+                      static_cast<GLsizei>(firsts.size()));
+    ++counters_m.draw_calls;
+}
+
+void renderer_t::render_fullscreen_triangle()
+{
+    render_vertex_object(fullscreen_triangle_m);
+}
+
+void renderer_t::upload_vertices(vertex_object_handle_t vertex_object, span_t<vertex_t> vertices)
+{
+    vertex_object->update(vertices);
+
+    ++counters_m.buffer_uploads;
+    counters_m.uploaded_bytes += vertices.size() * sizeof(vertex_t);
+}
+
+void renderer_t::begin_gpu_pass(const char* name)
+{
+    if(gpu_pass_active_m)
+        throw exception_t{fmt::format("GPU pass {} started within another pass", name)};
+
+    gpu_pass_active_m = true;
+
+    // Queries still in flight can't be begun again.
+    gpu_query_frame_t& frame = gpu_query_frames_m[gpu_query_frame_m];
+    gpu_query_active_m       = !frame.pending;
+    if(!gpu_query_active_m)
+        return;
+
+    if(frame.used == frame.queries.size())
+    {
+        gl_handle_t query;
+        glGenQueries(1, &query);
+
+        frame.queries.push_back(query);
+        frame.names.push_back(nullptr);
+    }
+
+    frame.names[frame.used] = name;
+    glBeginQuery(GL_TIME_ELAPSED, frame.queries[frame.used]);
+    ++frame.used;
+}
+
+void renderer_t::end_gpu_pass()
+{
+    if(gpu_query_active_m)
+        glEndQuery(GL_TIME_ELAPSED);
+
+    gpu_pass_active_m  = false;
+    gpu_query_active_m = false;
+}
+
+const std::vector<gpu_pass_time_t>& renderer_t::gpu_pass_times() const
+{
+    return gpu_pass_times_m;
+}
+
+const render_counters_t& renderer_t::frame_counters() const
+{
+    return frame_counters_m;
+}
+
+void renderer_t::bind_framebuffer(render_target_handle_t render_target)
+{
+    if(render_target == bound_render_target_m)
+        return;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, render_target ? render_target->gl_handle() : 0);
+    bound_render_target_m = std::move(render_target);
+}
+
+void renderer_t::set_viewport(glm::ivec4 viewport)
+{
+    if(viewport == viewport_m)
+        return;
+
+    glViewport(viewport.x, viewport.y, viewport.z, viewport.w);
+    viewport_m = viewport;
+}
+
+bool renderer_t::collect_gpu_pass_times(gpu_query_frame_t& frame)
+{
+    if(!frame.pending)
+        return true;
+
+    bool available = true;
+    for(size_t i = 0; i < frame.used && available; ++i)
+    {
+        GLint query_available = GL_FALSE;
+        glGetQueryObjectiv(frame.queries[i], GL_QUERY_RESULT_AVAILABLE, &query_available);
+        available = query_available == GL_TRUE;
+    }
+
+    // Still running, so keep showing the previous times rather than waiting.
+    if(!available)
+        return false;
+
+    gpu_pass_times_m.clear();
+    for(size_t i = 0; i < frame.used; ++i)
+    {
+        GLuint64 nanoseconds = 0;
+        glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &nanoseconds);
+
+        auto time = std::find_if(gpu_pass_times_m.begin(), gpu_pass_times_m.end(), [&](const auto& time) {
+            return std::string_view{time.name} == frame.names[i];
+        });
+
+        if(time == gpu_pass_times_m.end())
+            gpu_pass_times_m.push_back({frame.names[i], nanoseconds / 1e9});
+        else
+            time->seconds += nanoseconds / 1e9;
+    }
+
+    frame.used    = 0;
+    frame.pending = false;
+    return true;
+}
+
+draw_queue_t& renderer_t::draw_queue()
+{
+    return draw_queue_m;
 }
 
 std::vector<vertex_t>& renderer_t::batch_vertices()
@@ -190,40 +490,7 @@ void renderer_t::batch_sprite(vertex_batch_t& batch, glm::vec2 position, glm::ve
 
 void renderer_t::batch_character(vertex_batch_t& batch, font_handle_t font, glm::vec2 position, char character, glm::vec4 color)
 {
-    const glm::ivec2 count = font->character_count;
-    const glm::vec2  size  = font->character_size;
-
-    const glm::vec2 uv_size = glm::vec2{1.0f / count.x, 1.0f / count.y};
-    const glm::vec2 uv_coord{(float)(character % count.x) / count.x, (float)(character / count.x) / count.y};
-
-    const int passes = font->shadow ? 2 : 1;
-
-    for(int pass = 0; pass < passes; ++pass)
-    {
-        glm::vec2 temp_position = position;
-        glm::vec4 color_top     = color;
-        glm::vec4 color_bottom  = font->gradient ? color_top * 0.675f : color_top;
-
-        if(font->shadow && pass == 0)
-        {
-            temp_position += glm::vec2{1, 1};
-            color_top    = glm::vec4(0, 0, 0, 1);
-            color_bottom = glm::vec4(0, 0, 0, 1);
-        }
-
-        batch.insert(vertex_t{glm::vec3{temp_position, 0.0f}, uv_coord, color_top});
-        batch.insert(vertex_t{
-            glm::vec3{temp_position + glm::vec2{0.0f, size.y}, 0.0f}, uv_coord + glm::vec2{0.0f, uv_size.y}, color_bottom});
-        batch.insert(vertex_t{
-            glm::vec3{temp_position + glm::vec2{size.x, 0.0f}, 0.0f}, uv_coord + glm::vec2{uv_size.x, 0.0f}, color_top});
-        batch.insert(vertex_t{
-            glm::vec3{temp_position + glm::vec2{size.x, 0.0f}, 0.0f}, uv_coord + glm::vec2{uv_size.x, 0.0f}, color_top});
-        batch.insert(vertex_t{
-            glm::vec3{temp_position + glm::vec2{0.0f, size.y}, 0.0f}, uv_coord + glm::vec2{0.0f, uv_size.y}, color_bottom});
-        batch.insert(vertex_t{glm::vec3{temp_position + glm::vec2{size.x, size.y}, 0.0f},
-                              uv_coord + glm::vec2{uv_size.x, uv_size.y},
-                              color_bottom});
-    }
+    font->append_glyph(batch.vertices(), position, character, color);
 }
 
 void renderer_t::batch_string(vertex_batch_t&  batch,
@@ -232,7 +499,6 @@ void renderer_t::batch_string(vertex_batch_t&  batch,
                               std::string_view string,
                               glm::vec4        color)
 {
-    bind_texture(font->texture(), 0);
     glm::vec2 delta{font->character_size.x, 0.0f};
 
     for(size_t i = 0; i < string.size(); ++i)
@@ -242,28 +508,19 @@ void renderer_t::batch_string(vertex_batch_t&  batch,
     }
 }
 
-void renderer_t::batch_framebuffer_fullscreen(vertex_batch_t& batch, framebuffer_render_mode_t mode)
+glm::vec2 renderer_t::viewport_size() const
 {
-    // Since NDC has (-1, 1) in upper left, careful with vertex order - it's opposite of the orthographic vertex order for front
-    // faces. Also, the FBO textures have origin at (-1, -1), so keep that in mind.
-
-    float actual_aspect = engine_m.resolution().x / (float)engine_m.resolution().y;
-    float target_aspect = engine_m.viewport_size().x / (float)engine_m.viewport_size().y;
-
-    float correction = mode == framebuffer_render_mode_t::fill_ndc_k ? 1.0f : target_aspect / actual_aspect;
-
-    batch.insert(vertex_t{glm::vec3{-1 * correction, 1, 0}, glm::vec2{0, 1}});
-    batch.insert(vertex_t{glm::vec3{-1 * correction, -1, 0}, glm::vec2{0, 0}});
-    batch.insert(vertex_t{glm::vec3{1 * correction, 1, 0}, glm::vec2{1, 1}});
+    return engine_m.viewport_size();
+}
 
-    batch.insert(vertex_t{glm::vec3{-1 * correction, -1, 0}, glm::vec2{0, 0}});
-    batch.insert(vertex_t{glm::vec3{1 * correction, -1, 0}, glm::vec2{1, 0}});
-    batch.insert(vertex_t{glm::vec3{1 * correction, 1, 0}, glm::vec2{1, 1}});
+gpu_pass_guard_t::gpu_pass_guard_t(renderer_t& renderer, const char* name) : renderer_m(renderer)
+{
+    renderer_m.begin_gpu_pass(name);
 }
 
-glm::vec2 renderer_t::viewport_size() const
+gpu_pass_guard_t::~gpu_pass_guard_t()
 {
-    return engine_m.viewport_size();
+    renderer_m.end_gpu_pass();
 }
 
 } // namespace mau
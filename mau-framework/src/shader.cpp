@@ -4,9 +4,15 @@
 #include "mau/io/file_reader.hpp"
 #include "mau/io/resource_cache.hpp"
 #include "mau/rendering/GL/common.hpp"
+#include "mau/rendering/pass_constants.hpp"
+#include "mau/rendering/program_cache.hpp"
 
+#include <algorithm>
 #include <array>
+#include <cctype>
+#include <cstring>
 #include <string>
+#include <string_view>
 #include <fmt/format.h>
 
 namespace mau {
@@ -22,10 +28,10 @@ enum class shader_part_type_t
 class shader_part_t : non_copyable_t, non_movable_t
 {
 public:
-    shader_part_t(shader_part_type_t type, file_handle_t file)
+    shader_part_t(shader_part_type_t type, std::string_view source)
     {
-        const char*   text      = reinterpret_cast<const char*>(file->data());
-        const int32_t text_size = static_cast<int32_t>(file->size());
+        const char*   text      = source.data();
+        const int32_t text_size = static_cast<int32_t>(source.size());
 
         gl_handle_m = glCreateShader(type == shader_part_type_t::vertex_t ? GL_VERTEX_SHADER : GL_FRAGMENT_SHADER);
         glShaderSource(gl_handle_m, 1, &text, &text_size);
@@ -51,75 +57,182 @@ private:
     uint32_t gl_handle_m{0};
 };
 
-shader_handle_t shader_t::create(file_handle_t vertex_file, file_handle_t fragment_file)
+// Defines the features right after the #version line, which has to come first. The #line directive keeps the line
+// numbers in compilation errors matching the file.
+static std::string specialize_source(std::string_view source, shader_features_t features)
 {
-    return std::make_shared<shader_t>(vertex_file, fragment_file);
+    const size_t version_end = std::min(source.find('\n'), source.size());
+
+    std::string specialized{source.substr(0, version_end)};
+    specialized += '\n';
+
+    for(const auto& [feature, name]: shader_feature_mapping_k)
+    {
+        if(features & feature)
+            specialized += fmt::format("#define {}\n", name);
+    }
+
+    specialized += "#line 2\n";
+    if(version_end < source.size())
+        specialized += source.substr(version_end + 1);
+
+    return specialized;
 }
-shader_t::shader_t(file_handle_t vertex_file, file_handle_t fragment_file)
+static shader_features_t parse_shader_features(std::string_view list)
 {
-    shader_part_t vertexShader{shader_part_type_t::vertex_t, vertex_file};
-    shader_part_t fragmentShader{shader_part_type_t::fragment_t, fragment_file};
+    shader_features_t features = 0;
 
-    gl_handle_m = glCreateProgram();
+    while(!list.empty())
+    {
+        const size_t     separator = std::min(list.find(','), list.size());
+        std::string_view name      = list.substr(0, separator);
+        list.remove_prefix(std::min(separator + 1, list.size()));
+
+        while(!name.empty() && std::isspace(static_cast<unsigned char>(name.back())))
+            name.remove_suffix(1);
+        while(!name.empty() && std::isspace(static_cast<unsigned char>(name.front())))
+            name.remove_prefix(1);
 
-    glAttachShader(gl_handle_m, vertexShader.gl_handle());
-    glAttachShader(gl_handle_m, fragmentShader.gl_handle());
+        if(name.empty())
+            continue;
 
-    glLinkProgram(gl_handle_m);
+        auto feature = std::find_if(std::begin(shader_feature_mapping_k),
+                                    std::end(shader_feature_mapping_k),
+                                    [&](const auto& pair) { return name == pair.second; });
+        if(feature == std::end(shader_feature_mapping_k))
+            throw exception_t{fmt::format("unknown shader feature {}", name)};
 
-    int32_t success{false};
-    glGetProgramiv(gl_handle_m, GL_LINK_STATUS, &success);
-    if(!success)
+        features |= feature->first;
+    }
+
+    return features;
+}
+shader_handle_t shader_t::create(file_handle_t     vertex_file,
+                                 file_handle_t     fragment_file,
+                                 shader_features_t supported_features,
+                                 program_cache_t*  program_cache)
+{
+    std::string vertex_source{reinterpret_cast<const char*>(vertex_file->data()), vertex_file->size()};
+    std::string fragment_source{reinterpret_cast<const char*>(fragment_file->data()), fragment_file->size()};
+
+    return std::make_shared<shader_t>(
+        std::move(vertex_source), std::move(fragment_source), supported_features, 0, program_cache);
+}
+shader_t::shader_t(std::string       vertex_source,
+                   std::string       fragment_source,
+                   shader_features_t supported_features,
+                   shader_features_t features,
+                   program_cache_t*  program_cache) :
+    vertex_source_m(std::move(vertex_source)),
+    fragment_source_m(std::move(fragment_source)),
+    supported_features_m(supported_features),
+    features_m(features),
+    program_cache_m(program_cache)
+{
+    const std::string vertex_source_specialized   = specialize_source(vertex_source_m, features_m);
+    const std::string fragment_source_specialized = specialize_source(fragment_source_m, features_m);
+
+    gl_handle_m = glCreateProgram();
+
+    if(!program_cache_m || !program_cache_m->load(gl_handle_m, vertex_source_specialized, fragment_source_specialized))
     {
-        std::array<GLchar, error_buffer_size_k> error_buffer = {0};
-        glGetProgramInfoLog(gl_handle_m, static_cast<uint32_t>(error_buffer.size()), nullptr, error_buffer.data());
+        shader_part_t vertexShader{shader_part_type_t::vertex_t, vertex_source_specialized};
+        shader_part_t fragmentShader{shader_part_type_t::fragment_t, fragment_source_specialized};
+
+        glAttachShader(gl_handle_m, vertexShader.gl_handle());
+        glAttachShader(gl_handle_m, fragmentShader.gl_handle());
+
+        if(program_cache_m && program_cache_m->enabled())
+            glProgramParameteri(gl_handle_m, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 
-        glDeleteProgram(gl_handle_m);
+        glLinkProgram(gl_handle_m);
 
-        throw exception_t{fmt::format("shader linking error:\n{}", error_buffer.data())};
+        int32_t success{false};
+        glGetProgramiv(gl_handle_m, GL_LINK_STATUS, &success);
+        if(!success)
+        {
+            std::array<GLchar, error_buffer_size_k> error_buffer = {0};
+            glGetProgramInfoLog(gl_handle_m, static_cast<uint32_t>(error_buffer.size()), nullptr, error_buffer.data());
+
+            glDeleteProgram(gl_handle_m);
+
+            throw exception_t{fmt::format("shader linking error:\n{}", error_buffer.data())};
+        }
+
+        glDetachShader(gl_handle_m, vertexShader.gl_handle());
+        glDetachShader(gl_handle_m, fragmentShader.gl_handle());
+
+        if(program_cache_m)
+            program_cache_m->store(gl_handle_m, vertex_source_specialized, fragment_source_specialized);
     }
 
+    gl_uniforms_m.fill(-1);
     for(auto& pair: shader_uniform_mapping_k)
     {
         shader_uniform_t uniform        = pair.first;
         const char*      uniform_string = pair.second;
 
-        gl_uniform_mapping_m[uniform] = glGetUniformLocation(gl_handle_m, uniform_string);
+        gl_uniforms_m[static_cast<size_t>(uniform)] = glGetUniformLocation(gl_handle_m, uniform_string);
     }
+
+    const GLuint pass_constants_block = glGetUniformBlockIndex(gl_handle_m, pass_constants_block_k);
+    if(pass_constants_block != GL_INVALID_INDEX)
+        glUniformBlockBinding(gl_handle_m, pass_constants_block, pass_constants_binding_k);
 }
 shader_t::~shader_t()
 {
     glDeleteProgram(gl_handle_m);
 }
+shader_handle_t shader_t::variant(shader_features_t features)
+{
+    features &= supported_features_m;
+    if(features == features_m)
+        return shared_from_this();
+
+    auto& variant = variants_m[features];
+    if(!variant)
+        variant = std::make_shared<shader_t>(
+            vertex_source_m, fragment_source_m, supported_features_m, features, program_cache_m);
+
+    return variant;
+}
+shader_features_t shader_t::features() const
+{
+    return features_m;
+}
 void shader_t::set_uniform_mat4(shader_uniform_t uniform, const glm::mat4& value)
 {
-    glUniformMatrix4fv(gl_uniform(uniform), 1, GL_FALSE, glm::value_ptr(value));
+    if(shadow_uniform(uniform, value))
+        glUniformMatrix4fv(gl_uniform(uniform), 1, GL_FALSE, glm::value_ptr(value));
 }
 void shader_t::set_uniform_vec2(shader_uniform_t uniform, glm::vec2 value)
 {
-    glUniform2fv(gl_uniform(uniform), 1, glm::value_ptr(value));
+    if(shadow_uniform(uniform, value))
+        glUniform2fv(gl_uniform(uniform), 1, glm::value_ptr(value));
 }
 void shader_t::set_uniform_int(shader_uniform_t uniform, int32_t value)
 {
-    glUniform1i(gl_uniform(uniform), value);
+    if(shadow_uniform(uniform, value))
+        glUniform1i(gl_uniform(uniform), value);
 }
 void shader_t::set_uniform_bool(shader_uniform_t uniform, bool value)
 {
-    glUniform1i(gl_uniform(uniform), value);
+    set_uniform_int(uniform, value ? 1 : 0);
 }
 void shader_t::set_uniform_float(shader_uniform_t uniform, float value)
 {
-    glUniform1f(gl_uniform(uniform), value);
+    if(shadow_uniform(uniform, value))
+        glUniform1f(gl_uniform(uniform), value);
 }
 void shader_t::set_uniform_vec3_array(shader_uniform_t uniform, span_t<glm::vec3> values)
 {
-    if(values.size() == 0)
+    if(values.size() == 0 || gl_uniform(uniform) == -1)
         return;
     glUniform3fv(gl_uniform(uniform), (GLsizei)values.size(), (GLfloat*)values.data());
 }
 void shader_t::set_uniform_float_array(shader_uniform_t uniform, span_t<float> values)
 {
-    if(values.size() == 0)
+    if(values.size() == 0 || gl_uniform(uniform) == -1)
         return;
     glUniform1fv(gl_uniform(uniform), (GLsizei)values.size(), values.data());
 }
@@ -142,15 +255,41 @@ shader_handle_t shader_t::create_resource(engine_context_t& engine, file_handle_
     if(delimited_index == data.length())
         throw exception_t{"no shader delimited found"};
 
-    std::string_view vertex_shader_filename = std::string_view{data.data(), delimited_index};
-    std::string_view fragment_shader_filename =
-        std::string_view{data.data() + delimited_index + 1, data.size() - delimited_index - 1};
+    std::string_view vertex_shader_filename = data.substr(0, delimited_index);
+    std::string_view fragment_shader_filename = data.substr(delimited_index + 1);
+
+    // Optional list of features the shader can be specialized for.
+    std::string_view feature_list;
+    auto features_index = fragment_shader_filename.find_first_of(';');
+    if(features_index != std::string_view::npos)
+    {
+        feature_list             = fragment_shader_filename.substr(features_index + 1);
+        fragment_shader_filename = fragment_shader_filename.substr(0, features_index);
+    }
 
     return create(engine.resource_cache().load_file(vertex_shader_filename),
-                  engine.resource_cache().load_file(fragment_shader_filename));
+                  engine.resource_cache().load_file(fragment_shader_filename),
+                  parse_shader_features(feature_list),
+                  &engine.program_cache());
 }
-gl_uniform_handle_t shader_t::gl_uniform(shader_uniform_t uniform)
+gl_uniform_handle_t shader_t::gl_uniform(shader_uniform_t uniform) const
 {
-    return gl_uniform_mapping_m.at(uniform);
+    return gl_uniforms_m[static_cast<size_t>(uniform)];
+}
+template<typename T>
+bool shader_t::shadow_uniform(shader_uniform_t uniform, const T& value)
+{
+    static_assert(sizeof(T) <= sizeof(uniform_value_t::bytes), "uniform values must fit the shadow");
+
+    if(gl_uniform(uniform) == -1)
+        return false;
+
+    uniform_value_t& shadow = uniform_values_m[static_cast<size_t>(uniform)];
+    if(shadow.valid && std::memcmp(shadow.bytes.data(), &value, sizeof(T)) == 0)
+        return false;
+
+    std::memcpy(shadow.bytes.data(), &value, sizeof(T));
+    shadow.valid = true;
+    return true;
 }
 } // namespace mau
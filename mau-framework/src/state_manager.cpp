@@ -63,25 +63,28 @@ void state_manager_t::render(float delta_time)
     if(state_stack_m.empty())
         return;
 
-    renderer_t&     renderer           = engine_m.renderer();
-    shader_handle_t passthrough_shader = renderer.passthrough_shader();
+    renderer_t& renderer = engine_m.renderer();
 
-    renderer.clear({0.0f, 0.0f, 0.0f, 1.0f});
+    // Every state is composited over the ones below it. The window is cleared along with the first composite, since
+    // nothing draws into it before.
+    render_pass_t composite;
+    composite.shader      = renderer.passthrough_shader();
+    composite.clear_color = glm::vec4{0.0f, 0.0f, 0.0f, 1.0f};
+    composite.clear_depth = true;
+    composite.mode        = framebuffer_render_mode_t::perform_aspect_correction_k;
 
     for(auto& state: state_stack_m)
     {
         render_target_handle_t stateResult = state->render(delta_time);
 
-        depth_guard_t depth_lock{renderer, depth_test_t::disabled_k};
+        depth_guard_t    depth_lock{renderer, depth_test_t::disabled_k};
+        gpu_pass_guard_t gpu_pass{renderer, "composite"};
 
-        renderer.clear_render_target();
-        renderer.bind_shader(passthrough_shader);
-        passthrough_shader->set_uniform_int(shader_uniform_t::texture0_k, 0);
-        renderer.bind_texture(stateResult->texture(0), 0);
-        {
-            vertex_batch_t batch{renderer, vertex_primitive_t::triangle_k};
-            renderer.batch_framebuffer_fullscreen(batch, framebuffer_render_mode_t::perform_aspect_correction_k);
-        }
+        composite.inputs[0] = stateResult->texture(0);
+        renderer.draw_fullscreen_pass(composite);
+
+        composite.clear_color.reset();
+        composite.clear_depth = false;
     }
 }
 
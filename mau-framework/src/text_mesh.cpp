@@ -0,0 +1,101 @@
+#include "mau/rendering/text_mesh.hpp"
+
+#include "mau/rendering/renderer.hpp"
+
+namespace mau {
+
+void glyph_runs_t::begin(font_handle_t font)
+{
+    if(font != font_m)
+    {
+        font_m = font;
+        truncate(0);
+    }
+
+    run_count_m = 0;
+}
+void glyph_runs_t::add_run(glm::vec2 position, std::string_view string, glm::vec4 color)
+{
+    if(run_count_m < runs_m.size())
+    {
+        const run_t& run = runs_m[run_count_m];
+        if(run.string == string && run.position == position && run.color == color)
+        {
+            ++run_count_m;
+            return;
+        }
+
+        truncate(run_count_m);
+    }
+
+    const size_t first = vertices_m.size();
+
+    const glm::vec2 delta{font_m->character_size.x, 0.0f};
+    for(size_t i = 0; i < string.size(); ++i)
+        font_m->append_glyph(vertices_m, position + delta * (float)i, string[i], color);
+
+    runs_m.push_back({std::string{string}, position, color, first, vertices_m.size() - first});
+    ++run_count_m;
+    dirty_m = true;
+}
+bool glyph_runs_t::end()
+{
+    if(run_count_m < runs_m.size())
+        truncate(run_count_m);
+
+    const bool dirty = dirty_m;
+    dirty_m          = false;
+    return dirty;
+}
+const std::vector<vertex_t>& glyph_runs_t::vertices() const
+{
+    return vertices_m;
+}
+font_handle_t glyph_runs_t::font() const
+{
+    return font_m;
+}
+void glyph_runs_t::truncate(size_t run)
+{
+    if(run >= runs_m.size())
+        return;
+
+    vertices_m.resize(runs_m[run].first);
+    runs_m.resize(run);
+    dirty_m = true;
+}
+
+text_mesh_t::text_mesh_t(renderer_t& renderer) : renderer_m(renderer)
+{
+}
+void text_mesh_t::begin(font_handle_t font)
+{
+    runs_m.begin(font);
+}
+void text_mesh_t::add_run(glm::vec2 position, std::string_view string, glm::vec4 color)
+{
+    runs_m.add_run(position, string, color);
+}
+void text_mesh_t::draw()
+{
+    bool changed = runs_m.end();
+
+    const std::vector<vertex_t>& vertices = runs_m.vertices();
+    if(vertices.empty())
+        return;
+
+    if(!vertex_object_m)
+    {
+        vertex_object_m = vertex_object_t::create(
+            vertex_primitive_t::triangle_k, vertex_object_mode_t::dynamic_k, span_t<vertex_t>{});
+        changed = true;
+    }
+
+    if(changed)
+        renderer_m.upload_vertices(vertex_object_m, vertices);
+
+    renderer_m.bind_texture(runs_m.font()->texture(), 0);
+    renderer_m.render_vertex_object(vertex_object_m, 0, vertices.size());
+}
+
+} // namespace mau
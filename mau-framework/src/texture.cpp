@@ -6,6 +6,24 @@
 
 namespace mau {
 
+// Textures are bound to be set up, which would go past the renderer's shadowed state. Puts the texture bound before
+// back afterwards.
+class texture_binding_guard_t : non_copyable_t, non_movable_t
+{
+public:
+    texture_binding_guard_t()
+    {
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, &previous_texture_m);
+    }
+    ~texture_binding_guard_t()
+    {
+        glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(previous_texture_m));
+    }
+
+private:
+    GLint previous_texture_m{0};
+};
+
 texture_handle_t texture_t::create(glm::ivec2 size)
 {
     return std::make_shared<texture_t>(size);
@@ -17,6 +35,8 @@ texture_handle_t texture_t::create(image_handle_t image)
 
 texture_t::texture_t(glm::ivec2 size) : size_m(size)
 {
+    texture_binding_guard_t binding_guard;
+
     glGenTextures(1, &gl_handle_m);
     glBindTexture(GL_TEXTURE_2D, gl_handle_m);
 
@@ -34,6 +54,8 @@ texture_t::texture_t(image_handle_t image) : size_m(image->size())
 {
     const auto& pixels = image->rgba();
 
+    texture_binding_guard_t binding_guard;
+
     glGenTextures(1, &gl_handle_m);
     glBindTexture(GL_TEXTURE_2D, gl_handle_m);
 
@@ -61,6 +83,17 @@ gl_handle_t texture_t::gl_handle() const
     return gl_handle_m;
 }
 
+void texture_t::set_filter(texture_filter_t filter)
+{
+    const GLint gl_filter = filter == texture_filter_t::linear_k ? GL_LINEAR : GL_NEAREST;
+
+    texture_binding_guard_t binding_guard;
+
+    glBindTexture(GL_TEXTURE_2D, gl_handle_m);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, gl_filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, gl_filter);
+}
+
 texture_handle_t texture_t::create_resource(engine_context_t& engine, file_handle_t file)
 {
     return create(image_t::create(file));
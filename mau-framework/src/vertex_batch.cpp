@@ -12,12 +12,16 @@ vertex_batch_t::vertex_batch_t(renderer_t& renderer, vertex_primitive_t primitiv
 vertex_batch_t::~vertex_batch_t()
 {
     vertex_object_m->set_primitive(primitive_m);
-    vertex_object_m->update(vertices_m);
+    renderer_m.upload_vertices(vertex_object_m, vertices_m);
     renderer_m.render_vertex_object(vertex_object_m);
 }
 void vertex_batch_t::insert(const vertex_t& vertex)
 {
     vertices_m.push_back(vertex);
 }
+std::vector<vertex_t>& vertex_batch_t::vertices()
+{
+    return vertices_m;
+}
 
 } // namespace mau
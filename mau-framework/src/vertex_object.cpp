@@ -10,7 +10,7 @@ vertex_object_handle_t vertex_object_t::create(vertex_primitive_t primitive, ver
 }
 
 vertex_object_t::vertex_object_t(vertex_primitive_t primitive, vertex_object_mode_t mode, span_t<vertex_t> vertices) :
-    primitive_m(primitive), mode_m(mode), vertex_count_m(vertices.size())
+    primitive_m(primitive), mode_m(mode), vertex_count_m(vertices.size()), vertex_capacity_m(vertices.size())
 {
     glGenVertexArrays(1, &gl_vao_handle_m);
     glBindVertexArray(gl_vao_handle_m);
@@ -40,13 +40,19 @@ void vertex_object_t::update(span_t<vertex_t> vertices)
     glBindVertexArray(gl_vao_handle_m);
     glBindBuffer(GL_ARRAY_BUFFER, gl_vbo_handle_m);
 
-    if(vertices.size() <= vertex_count_m)
+    if(vertices.size() <= vertex_capacity_m)
     {
+        // Streamed buffers are rewritten every frame, so orphan the old storage first. That way the driver doesn't have to
+        // wait for draws still reading from it.
+        if(mode_m == vertex_object_mode_t::stream_k)
+            glBufferData(GL_ARRAY_BUFFER, vertex_capacity_m * sizeof(vertex_t), nullptr, gl_mode(mode_m));
+
         glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(vertex_t), vertices.data());
     }
     else
     {
         glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(vertex_t), vertices.data(), gl_mode(mode_m));
+        vertex_capacity_m = vertices.size();
     }
 
     vertex_count_m = vertices.size();
@@ -57,6 +63,10 @@ size_t vertex_object_t::vertex_count() const
 {
     return vertex_count_m;
 }
+size_t vertex_object_t::vertex_capacity() const
+{
+    return vertex_capacity_m;
+}
 uint32_t vertex_object_t::gl_handle() const
 {
     return gl_vao_handle_m;
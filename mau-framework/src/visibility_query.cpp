@@ -0,0 +1,44 @@
+#include "mau/math/visibility_query.hpp"
+
+#include <algorithm>
+
+namespace mau {
+
+visibility_query_t::visibility_query_t(const potentially_visible_set_t& set) :
+    set_m(&set), region_frames_m(set.region_count().x * set.region_count().y, 0)
+{
+    visible_regions_m.reserve(region_frames_m.size());
+}
+void visibility_query_t::begin_frame(glm::vec2 origin, glm::vec2 direction, float half_angle)
+{
+    // Stamps from before the counter wrapped around would read as visible again.
+    if(++frame_m == 0)
+    {
+        std::fill(region_frames_m.begin(), region_frames_m.end(), 0);
+        frame_m = 1;
+    }
+
+    wedge_m = math::make_view_wedge(origin, direction, half_angle);
+    visible_regions_m.clear();
+
+    const float   region_size   = static_cast<float>(set_m->region_size());
+    const int32_t origin_region = set_m->region_index(glm::floor(origin));
+
+    for(auto region: set_m->visible_regions(origin_region))
+    {
+        const glm::vec2 region_min = glm::vec2{set_m->region_position(region)} * region_size;
+        const glm::vec2 region_max = region_min + glm::vec2{region_size, region_size};
+
+        if(!math::aabb_view_wedge_intersect(region_min, region_max, wedge_m))
+            continue;
+
+        region_frames_m[region] = frame_m;
+        visible_regions_m.push_back(region);
+    }
+}
+span_t<uint32_t> visibility_query_t::visible_regions() const
+{
+    return span_t<uint32_t>{visible_regions_m.data(), visible_regions_m.size()};
+}
+
+} // namespace mau
@@ -0,0 +1,17 @@
+#include "catch.hpp"
+
+#include <mau/math/checksum.hpp>
+
+using namespace mau;
+
+TEST_CASE("fnv1a64 matches reference values", "[checksum]")
+{
+    REQUIRE(fnv1a64("") == 0xcbf29ce484222325ULL);
+    REQUIRE(fnv1a64("a") == 0xaf63dc4c8601ec8cULL);
+    REQUIRE(fnv1a64("foobar") == 0x85944171f73967e8ULL);
+}
+
+TEST_CASE("fnv1a64 chains across pieces", "[checksum]")
+{
+    REQUIRE(fnv1a64("bar", fnv1a64("foo")) == fnv1a64("foobar"));
+}
@@ -0,0 +1,60 @@
+#include "catch.hpp"
+
+#include <mau/rendering/draw_queue.hpp>
+
+using namespace mau;
+
+TEST_CASE("draw_queue_t sort keys order by pass, shader, texture and depth", "[draw_queue_t]")
+{
+    const auto key = draw_queue_t::sort_key;
+
+    // Each part outweighs all parts after it.
+    REQUIRE(key(draw_pass_t::opaque_k, 9, 9, 100.0f) < key(draw_pass_t::alpha_tested_k, 1, 1, 0.0f));
+    REQUIRE(key(draw_pass_t::opaque_k, 1, 9, 100.0f) < key(draw_pass_t::opaque_k, 2, 1, 0.0f));
+    REQUIRE(key(draw_pass_t::opaque_k, 1, 1, 100.0f) < key(draw_pass_t::opaque_k, 1, 2, 0.0f));
+
+    // Front to back, down to small differences in depth.
+    REQUIRE(key(draw_pass_t::opaque_k, 1, 1, 0.0f) < key(draw_pass_t::opaque_k, 1, 1, 0.001f));
+    REQUIRE(key(draw_pass_t::opaque_k, 1, 1, 10.0f) < key(draw_pass_t::opaque_k, 1, 1, 10.001f));
+    REQUIRE(key(draw_pass_t::opaque_k, 1, 1, 10.0f) < key(draw_pass_t::opaque_k, 1, 1, 1000.0f));
+
+    // Translucent draws go back to front.
+    REQUIRE(key(draw_pass_t::translucent_k, 1, 1, 10.0f) > key(draw_pass_t::translucent_k, 1, 1, 20.0f));
+    REQUIRE(key(draw_pass_t::alpha_tested_k, 9, 9, 0.0f) < key(draw_pass_t::translucent_k, 1, 1, 1000.0f));
+}
+
+TEST_CASE("draw_queue_t depth bits order like depths", "[draw_queue_t]")
+{
+    const auto bits = draw_queue_t::depth_bits;
+
+    REQUIRE(bits(0.0f) < bits(0.001f));
+    REQUIRE(bits(0.5f) < bits(1.0f));
+    REQUIRE(bits(10.0f) < bits(10.001f));
+    REQUIRE(bits(1000.0f) < bits(1.0e6f));
+}
+
+TEST_CASE("draw_ranges_t hands out the index of the first range pushed", "[draw_ranges_t]")
+{
+    draw_ranges_t ranges;
+
+    const std::vector<int32_t> chunk_firsts = {0, 600, 1200};
+    const std::vector<int32_t> chunk_counts = {600, 300, 900};
+    const std::vector<int32_t> other_firsts = {42};
+    const std::vector<int32_t> other_counts = {6};
+
+    REQUIRE(ranges.push(chunk_firsts, chunk_counts) == 0);
+    REQUIRE(ranges.push(other_firsts, other_counts) == 3);
+    REQUIRE(ranges.size() == 4);
+
+    const span_t<int32_t> firsts = ranges.firsts(1, 3);
+    const span_t<int32_t> counts = ranges.counts(1, 3);
+    REQUIRE(firsts.size() == 3);
+    REQUIRE(std::vector<int32_t>(firsts.begin(), firsts.end()) == std::vector<int32_t>{600, 1200, 42});
+    REQUIRE(std::vector<int32_t>(counts.begin(), counts.end()) == std::vector<int32_t>{300, 900, 6});
+
+    // The queue clears its ranges once executed, after which indices start over.
+    ranges.clear();
+    REQUIRE(ranges.size() == 0);
+    REQUIRE(ranges.push(other_firsts, other_counts) == 0);
+    REQUIRE(*ranges.firsts(0, 1).begin() == 42);
+}
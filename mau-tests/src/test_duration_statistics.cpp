@@ -0,0 +1,32 @@
+#include "catch.hpp"
+
+#include <mau/base/duration_statistics.hpp>
+
+using namespace mau;
+
+TEST_CASE("duration_statistics summarizes durations", "[duration_statistics]")
+{
+    // 1 to 200 milliseconds, shuffled.
+    std::vector<uint64_t> durations;
+    for(uint64_t i = 0; i < 200; ++i)
+        durations.push_back(((i * 37) % 200 + 1) * 1000);
+
+    const auto statistics = duration_statistics(durations);
+
+    REQUIRE(statistics.count == 200);
+    REQUIRE(statistics.total == Approx(20.1));
+    REQUIRE(statistics.average == Approx(0.1005));
+    REQUIRE(statistics.median == Approx(0.100));
+    REQUIRE(statistics.percentile_99 == Approx(0.198));
+    REQUIRE(statistics.maximum == Approx(0.200));
+}
+
+TEST_CASE("duration_statistics handles no durations", "[duration_statistics]")
+{
+    std::vector<uint64_t> durations;
+
+    const auto statistics = duration_statistics(durations);
+
+    REQUIRE(statistics.count == 0);
+    REQUIRE(statistics.maximum == 0.0);
+}
@@ -0,0 +1,81 @@
+#include "catch.hpp"
+
+#include <mau/base/engine_options.hpp>
+
+using namespace mau;
+
+TEST_CASE("engine_options_t defaults to a regular run", "[engine_options_t]")
+{
+    const char* argv[] = {"worship"};
+
+    const auto options = engine_options_t::parse(1, argv);
+    REQUIRE(!options.headless);
+    REQUIRE(options.frame_limit == 0);
+    REQUIRE(!options.unattended());
+    REQUIRE(options.shader_cache);
+    REQUIRE(options.frame_pacer.fixed_rate == frame_pacer_settings_t{}.fixed_rate);
+    REQUIRE(options.frame_pacer.frame_rate_limit == 0.0);
+}
+
+TEST_CASE("engine_options_t turns off the shader cache", "[engine_options_t]")
+{
+    const char* argv[] = {"worship", "--no-shader-cache"};
+
+    const auto options = engine_options_t::parse(2, argv);
+    REQUIRE(!options.shader_cache);
+    REQUIRE(!options.unattended());
+}
+
+TEST_CASE("engine_options_t parses frame pacing", "[engine_options_t]")
+{
+    const char* argv[] = {
+        "worship", "--tick-rate", "120", "--max-substeps", "8", "--fps-limit", "144.5", "--spin-limiter"};
+
+    const auto options = engine_options_t::parse(8, argv);
+    REQUIRE(options.frame_pacer.fixed_rate == 120.0);
+    REQUIRE(options.frame_pacer.max_substeps == 8);
+    REQUIRE(options.frame_pacer.frame_rate_limit == 144.5);
+    REQUIRE(options.frame_pacer.limiter == frame_limiter_t::spin_k);
+    REQUIRE(!options.unattended());
+}
+
+TEST_CASE("engine_options_t parses headless runs with a frame limit", "[engine_options_t]")
+{
+    const char* argv[] = {"worship", "--frames", "600", "--headless"};
+
+    const auto options = engine_options_t::parse(4, argv);
+    REQUIRE(options.headless);
+    REQUIRE(options.frame_limit == 600);
+    REQUIRE(options.unattended());
+}
+
+TEST_CASE("engine_options_t parses recording, timedemo and profile files", "[engine_options_t]")
+{
+    const char* argv[] = {"worship", "--record", "demo1.rec", "--timedemo", "demo2.rec", "--profile", "trace.json"};
+
+    const auto options = engine_options_t::parse(7, argv);
+    REQUIRE(options.record_path == "demo1.rec");
+    REQUIRE(options.timedemo_path == "demo2.rec");
+    REQUIRE(options.profile_path == "trace.json");
+    REQUIRE(!options.headless);
+    REQUIRE(options.unattended());
+}
+
+TEST_CASE("engine_options_t rejects malformed options", "[engine_options_t]")
+{
+    const char* missing[]  = {"worship", "--frames"};
+    const char* invalid[]  = {"worship", "--frames", "60x"};
+    const char* negative[] = {"worship", "--frames", "-1"};
+    const char* unknown[]  = {"worship", "--fast"};
+    const char* no_file[]  = {"worship", "--timedemo"};
+    const char* no_rate[]  = {"worship", "--tick-rate", "0"};
+    const char* no_steps[] = {"worship", "--max-substeps", "0"};
+
+    REQUIRE_THROWS_AS(engine_options_t::parse(2, missing), exception_t);
+    REQUIRE_THROWS_AS(engine_options_t::parse(3, invalid), exception_t);
+    REQUIRE_THROWS_AS(engine_options_t::parse(3, negative), exception_t);
+    REQUIRE_THROWS_AS(engine_options_t::parse(2, unknown), exception_t);
+    REQUIRE_THROWS_AS(engine_options_t::parse(2, no_file), exception_t);
+    REQUIRE_THROWS_AS(engine_options_t::parse(3, no_rate), exception_t);
+    REQUIRE_THROWS_AS(engine_options_t::parse(3, no_steps), exception_t);
+}
@@ -0,0 +1,79 @@
+#include "catch.hpp"
+
+#include <mau/math/flow_field.hpp>
+
+using namespace mau;
+
+// Two rooms side by side, joined by a doorway in the wall between them. The corner room is sealed off.
+static bit_grid_t create_rooms()
+{
+    bit_grid_t grid{{16, 8}};
+    for(int32_t y = 0; y < 8; ++y)
+        grid.set({7, y}, y != 4);
+
+    for(int32_t x = 12; x < 16; ++x)
+        grid.set({x, 5}, true);
+    for(int32_t y = 5; y < 8; ++y)
+        grid.set({12, y}, true);
+
+    return grid;
+}
+
+TEST_CASE("flow_field_t leads to the target", "[flow_field_t]")
+{
+    const bit_grid_t grid = create_rooms();
+    flow_field_t     field{grid};
+
+    field.compute({10, 1});
+
+    REQUIRE(field.target() == glm::ivec2{10, 1});
+    REQUIRE(field.distance({10, 1}) == 0);
+    REQUIRE(field.next_cell({10, 1}) == glm::ivec2{10, 1});
+
+    // Follow the field from the far corner of the other room, through the doorway.
+    glm::ivec2 cell{0, 0};
+    bool       through_doorway{false};
+
+    for(uint32_t moves = field.distance(cell); moves > 0; --moves)
+    {
+        const glm::ivec2 next = field.next_cell(cell);
+
+        REQUIRE(!grid.get(next));
+        REQUIRE(field.distance(next) == field.distance(cell) - 1);
+
+        through_doorway |= next == glm::ivec2{7, 4};
+        cell = next;
+    }
+
+    REQUIRE(cell == glm::ivec2{10, 1});
+    REQUIRE(through_doorway);
+}
+
+TEST_CASE("flow_field_t doesn't cut corners", "[flow_field_t]")
+{
+    const bit_grid_t grid = create_rooms();
+    flow_field_t     field{grid};
+
+    field.compute({8, 3});
+
+    // Straight through the doorway, instead of diagonally past the wall.
+    REQUIRE(field.next_cell({6, 4}) == glm::ivec2{7, 4});
+    REQUIRE(field.next_cell({7, 4}) == glm::ivec2{8, 4});
+    REQUIRE(field.distance({6, 3}) == 4);
+}
+
+TEST_CASE("flow_field_t handles unreachable cells", "[flow_field_t]")
+{
+    const bit_grid_t grid = create_rooms();
+    flow_field_t     field{grid};
+
+    field.compute({2, 2});
+
+    REQUIRE(field.distance({14, 7}) == flow_field_t::unreachable_k);
+    REQUIRE(field.next_cell({14, 7}) == glm::ivec2{14, 7});
+    REQUIRE(field.distance({-1, 0}) == flow_field_t::unreachable_k);
+
+    // Nothing leads into a wall.
+    field.compute({7, 0});
+    REQUIRE(field.distance({6, 0}) == flow_field_t::unreachable_k);
+}
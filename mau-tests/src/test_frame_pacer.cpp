@@ -0,0 +1,117 @@
+#include "catch.hpp"
+
+#include <mau/base/frame_pacer.hpp>
+
+using namespace mau;
+
+static frame_pacer_settings_t create_settings()
+{
+    frame_pacer_settings_t settings;
+    settings.fixed_rate      = 100.0;
+    settings.max_substeps    = 4;
+    settings.hitch_threshold = 0.5;
+    return settings;
+}
+
+TEST_CASE("frame_pacer_t splits time into fixed steps", "[frame_pacer_t]")
+{
+    frame_pacer_t pacer{create_settings()};
+
+    REQUIRE(pacer.fixed_delta_time() == Approx(0.01f));
+
+    // First frame only marks the start.
+    REQUIRE(pacer.advance(1000000) == 0);
+
+    REQUIRE(pacer.advance(1025000) == 2);
+    REQUIRE(pacer.alpha() == Approx(0.5f));
+    REQUIRE(pacer.frame_delta_time() == Approx(0.025f));
+
+    // Left over time carries over.
+    REQUIRE(pacer.advance(1030000) == 1);
+    REQUIRE(pacer.alpha() == Approx(0.0f));
+}
+
+TEST_CASE("frame_pacer_t runs a fixed number of steps per frame in lockstep", "[frame_pacer_t]")
+{
+    frame_pacer_settings_t settings = create_settings();
+    settings.lockstep_steps         = 1;
+
+    frame_pacer_t pacer{settings};
+
+    // Steps don't depend on how much time passed, be it next to none or a lot.
+    REQUIRE(pacer.advance(0) == 1);
+    REQUIRE(pacer.advance(10) == 1);
+    REQUIRE(pacer.advance(1000000) == 1);
+    REQUIRE(pacer.alpha() == Approx(0.0f));
+    REQUIRE(pacer.fixed_delta_time() == Approx(0.01f));
+
+    // Frame times are still real ones.
+    REQUIRE(pacer.frame_delta_time() == Approx(0.99999f));
+    REQUIRE(pacer.statistics().hitch_count == 0);
+    REQUIRE(pacer.statistics().dropped_steps == 0);
+}
+
+TEST_CASE("frame_pacer_t caps steps per frame", "[frame_pacer_t]")
+{
+    frame_pacer_t pacer{create_settings()};
+
+    pacer.advance(0);
+    REQUIRE(pacer.advance(100000) == 4);
+    REQUIRE(pacer.statistics().dropped_steps == 6);
+
+    // Dropped time isn't made up for later.
+    REQUIRE(pacer.advance(110000) == 1);
+}
+
+TEST_CASE("frame_pacer_t skips hitches", "[frame_pacer_t]")
+{
+    frame_pacer_t pacer{create_settings()};
+
+    pacer.advance(0);
+    REQUIRE(pacer.advance(2000000) == 1);
+    REQUIRE(pacer.statistics().hitch_count == 1);
+    REQUIRE(pacer.statistics().dropped_steps == 0);
+
+    // Time after a reset isn't caught up on either.
+    pacer.reset();
+    REQUIRE(pacer.advance(5000000) == 0);
+    REQUIRE(pacer.advance(5010000) == 1);
+}
+
+TEST_CASE("frame_pacer_t gathers frame time statistics", "[frame_pacer_t]")
+{
+    frame_pacer_t pacer{create_settings()};
+
+    uint64_t time = 0;
+    pacer.advance(time);
+    for(uint64_t i = 1; i <= 100; ++i)
+    {
+        time += i * 100;
+        pacer.advance(time);
+    }
+
+    const frame_statistics_t statistics = pacer.statistics();
+    REQUIRE(statistics.minimum == Approx(0.0001));
+    REQUIRE(statistics.maximum == Approx(0.01));
+    REQUIRE(statistics.average == Approx(0.00505));
+    REQUIRE(statistics.percentile_99 == Approx(0.0099));
+}
+
+TEST_CASE("frame_pacer_t holds frames back to the limit", "[frame_pacer_t]")
+{
+    frame_pacer_settings_t settings = create_settings();
+    settings.frame_rate_limit       = 200.0;
+
+    for(auto limiter: {frame_limiter_t::sleep_k, frame_limiter_t::spin_k})
+    {
+        settings.limiter = limiter;
+
+        frame_pacer_t pacer{settings};
+        mau::timer_t  timer;
+
+        pacer.advance(timer.microseconds());
+        pacer.limit_frame_rate(timer);
+
+        REQUIRE(timer.microseconds() >= 5000);
+    }
+}
@@ -0,0 +1,51 @@
+#include "catch.hpp"
+
+#include <mau/threading/job_system.hpp>
+
+using namespace mau;
+
+TEST_CASE("job_system_t covers every index exactly once", "[job_system_t]")
+{
+    for(size_t worker_count: {0, 1, 3})
+    {
+        job_system_t jobs{worker_count};
+        REQUIRE(jobs.thread_count() == worker_count + 1);
+
+        for(size_t grain: {1, 7, 64, 1000})
+        {
+            // Catch can't be used from other threads, so check ranges afterwards.
+            std::vector<std::atomic<uint32_t>> visits(500);
+            std::atomic<bool>                  misaligned{false};
+
+            jobs.parallel_for(visits.size(), grain, [&](size_t begin, size_t end) {
+                if(begin % grain != 0 || end - begin > grain)
+                    misaligned = true;
+
+                for(size_t i = begin; i < end; ++i)
+                    ++visits[i];
+            });
+
+            REQUIRE(!misaligned);
+            for(const auto& visit: visits)
+                REQUIRE(visit == 1);
+        }
+    }
+}
+
+TEST_CASE("job_system_t rethrows exceptions on the calling thread", "[job_system_t]")
+{
+    job_system_t jobs{2};
+
+    REQUIRE_THROWS_AS(jobs.parallel_for(100,
+                                        10,
+                                        [](size_t begin, size_t) {
+                                            if(begin == 50)
+                                                throw exception_t{"failed"};
+                                        }),
+                      exception_t);
+
+    // Still usable afterwards.
+    std::atomic<size_t> sum{0};
+    jobs.parallel_for(100, 10, [&](size_t begin, size_t end) { sum += end - begin; });
+    REQUIRE(sum == 100);
+}
@@ -0,0 +1,64 @@
+#include "catch.hpp"
+
+#include <mau/memory/object_pool.hpp>
+
+using namespace mau;
+
+struct counted_t
+{
+    explicit counted_t(int* counter) : counter_m(counter)
+    {
+        ++*counter_m;
+    }
+    ~counted_t()
+    {
+        --*counter_m;
+    }
+
+    int* counter_m;
+};
+
+TEST_CASE("object_pool_t constructs and destroys objects", "[object_pool_t]")
+{
+    int                         alive = 0;
+    object_pool_t<counted_t, 4> pool;
+
+    counted_t* a = pool.create(&alive);
+    counted_t* b = pool.create(&alive);
+    REQUIRE(alive == 2);
+    REQUIRE(pool.size() == 2);
+    REQUIRE(a != b);
+
+    pool.destroy(a);
+    pool.destroy(b);
+    REQUIRE(alive == 0);
+    REQUIRE(pool.size() == 0);
+}
+
+TEST_CASE("object_pool_t reuses slots instead of growing", "[object_pool_t]")
+{
+    int                         alive = 0;
+    object_pool_t<counted_t, 4> pool;
+
+    std::vector<counted_t*> objects;
+    for(int i = 0; i < 6; ++i)
+        objects.push_back(pool.create(&alive));
+
+    REQUIRE(pool.capacity() == 8);
+
+    // Churn through the pool well past its capacity - it must never grow beyond the peak.
+    for(int round = 0; round < 100; ++round)
+    {
+        for(auto object: objects)
+            pool.destroy(object);
+        for(auto& object: objects)
+            object = pool.create(&alive);
+    }
+
+    REQUIRE(pool.capacity() == 8);
+    REQUIRE(alive == 6);
+
+    for(auto object: objects)
+        pool.destroy(object);
+    REQUIRE(alive == 0);
+}
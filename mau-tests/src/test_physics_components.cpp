@@ -0,0 +1,107 @@
+#include "catch.hpp"
+
+#include <worship/gameplay/entity.hpp>
+#include <worship/gameplay/physics_components.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+
+using namespace mau;
+
+static constexpr size_t benchmark_body_count_k = 10000;
+
+// Friction is left at zero, or velocities would decay into denormals as benchmarks keep running, which are slow enough
+// to drown out everything else.
+static void create_bodies(physics_components_t& physics, std::mt19937& random, size_t count)
+{
+    std::uniform_real_distribution<float> distribution{-4.0f, 4.0f};
+
+    for(size_t i = 0; i < count; ++i)
+    {
+        const physics_index_t index = physics.create(nullptr);
+        physics.velocities[index]   = {distribution(random), distribution(random), distribution(random)};
+        physics.gravities[index]    = i % 2;
+    }
+}
+
+TEST_CASE("physics_components_t applies gravity and friction per body", "[physics_components_t]")
+{
+    physics_components_t physics;
+    physics.create(nullptr);
+    physics.create(nullptr);
+
+    physics.velocities = {{1, 0, 0}, {1, 0, 0}};
+    physics.gravities  = {true, false};
+    physics.masses     = {2.0f, 1.0f};
+    physics.frictions  = {0.5f, 0.0f};
+
+    physics.integrate_gravity(0.5f);
+    physics.apply_friction();
+
+    REQUIRE(physics.velocities[0] == glm::vec3{0.5f, -gravity_constant_k * 0.5f / 2.0f * 0.5f, 0.0f});
+    REQUIRE(physics.velocities[1] == glm::vec3{1.0f, 0.0f, 0.0f});
+}
+
+// The physics passes of a tick over the component arrays, against the same work done through a virtual update per
+// heap allocated object, as it was before the state moved into the arrays.
+TEST_CASE("physics_components_t benchmark", "[physics_components_t][!benchmark]")
+{
+    static constexpr float delta_time_k = 1.0f / 60.0f;
+
+    struct object_t
+    {
+        virtual ~object_t() = default;
+
+        virtual void fixed_update(float delta_time)
+        {
+            if(gravity)
+                velocity.y -= gravity_constant_k * delta_time / mass;
+
+            position += velocity * delta_time;
+            velocity -= velocity * friction;
+        }
+
+        glm::vec3 position{};
+        glm::vec3 velocity{};
+        glm::vec3 bounding_box{1, 1, 1};
+        float     mass{1.0f};
+        float     friction{0.0f};
+        bool      gravity{false};
+    };
+
+    std::mt19937 random{42};
+
+    physics_components_t physics;
+    create_bodies(physics, random, benchmark_body_count_k);
+
+    // Objects allocated in between other allocations, and updated in an order unrelated to where they live.
+    std::vector<std::unique_ptr<object_t>> objects;
+    std::vector<std::unique_ptr<char[]>>   padding;
+    for(size_t i = 0; i < benchmark_body_count_k; ++i)
+    {
+        objects.push_back(std::make_unique<object_t>());
+        objects.back()->velocity = physics.velocities[i];
+        objects.back()->gravity  = physics.gravities[i];
+        padding.push_back(std::make_unique<char[]>(64 + random() % 256));
+    }
+    std::shuffle(objects.begin(), objects.end(), random);
+
+    BENCHMARK("objects, 10k bodies")
+    {
+        for(auto& object: objects)
+            object->fixed_update(delta_time_k);
+        return objects.front()->position.x;
+    };
+
+    BENCHMARK("components, 10k bodies")
+    {
+        physics.integrate_gravity(delta_time_k);
+
+        for(size_t i = 0; i < physics.size(); ++i)
+            physics.positions[i] += physics.velocities[i] * delta_time_k;
+
+        physics.apply_friction();
+        return physics.positions.front().x;
+    };
+}
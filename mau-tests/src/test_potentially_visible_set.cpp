@@ -0,0 +1,66 @@
+#include "catch.hpp"
+
+#include <mau/math/grid_raycast.hpp>
+#include <mau/math/potentially_visible_set.hpp>
+#include <mau/threading/job_system.hpp>
+
+#include <algorithm>
+
+using namespace mau;
+
+// Two 8x8 regions side by side, separated by a wall along their shared edge. Wall cells belong to the region they're
+// in and are visible from wherever they're hit, so the wall is two cells thick - one per region.
+static bit_grid_t create_split_grid(bool with_doorway)
+{
+    bit_grid_t grid{{16, 8}};
+    for(int32_t y = 0; y < 8; ++y)
+    {
+        grid.set({7, y}, true);
+        grid.set({8, y}, true);
+    }
+
+    if(with_doorway)
+    {
+        grid.set({7, 4}, false);
+        grid.set({8, 4}, false);
+    }
+
+    return grid;
+}
+
+static bool contains(span_t<uint32_t> regions, uint32_t region)
+{
+    return std::find(regions.begin(), regions.end(), region) != regions.end();
+}
+
+TEST_CASE("grid_raycast stops at the first set cell", "[grid_raycast]")
+{
+    bit_grid_t grid = create_split_grid(false);
+
+    int32_t visited = 0;
+    auto    hit     = math::grid_raycast(grid, {0.5f, 0.5f}, {1.0f, 0.0f}, [&](glm::ivec2) {
+        ++visited;
+        return true;
+    });
+
+    REQUIRE(visited == 8);
+    REQUIRE(hit.x == Approx(7.0f));
+    REQUIRE(hit.y == Approx(0.5f));
+}
+
+TEST_CASE("potentially_visible_set_t respects walls", "[potentially_visible_set_t]")
+{
+    job_system_t jobs{0};
+
+    potentially_visible_set_t closed{create_split_grid(false), 8, jobs};
+
+    REQUIRE(closed.region_count() == glm::ivec2{2, 1});
+    REQUIRE(contains(closed.visible_regions(0), 0));
+    REQUIRE_FALSE(contains(closed.visible_regions(0), 1));
+    REQUIRE_FALSE(contains(closed.visible_regions(1), 0));
+
+    potentially_visible_set_t open{create_split_grid(true), 8, jobs};
+
+    REQUIRE(contains(open.visible_regions(0), 1));
+    REQUIRE(contains(open.visible_regions(1), 0));
+}
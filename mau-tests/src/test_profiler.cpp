@@ -0,0 +1,111 @@
+#include "catch.hpp"
+
+#include <mau/profiling/profiler.hpp>
+#include <mau/threading/job_system.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace mau;
+
+static const profile_zone_summary_t* find_zone(const profiler_t& profiler, std::string_view name)
+{
+    for(const auto& zone: profiler.frame_summary())
+    {
+        if(name == zone.name)
+            return &zone;
+    }
+
+    return nullptr;
+}
+
+TEST_CASE("profiler_t summarizes nested zones per frame", "[profiler_t]")
+{
+    profiler_t profiler;
+    profiler.set_enabled(true);
+    REQUIRE(profiler_t::active() == &profiler);
+
+    profiler.begin_frame();
+    {
+        MAU_PROFILE_ZONE("outer");
+        for(int i = 0; i < 3; ++i)
+        {
+            MAU_PROFILE_ZONE("inner");
+        }
+    }
+    profiler.begin_frame();
+
+    const auto& summary = profiler.frame_summary();
+    REQUIRE(summary.size() == 2);
+
+    REQUIRE(std::string_view{summary[0].name} == "outer");
+    REQUIRE(summary[0].depth == 0);
+    REQUIRE(summary[0].calls == 1);
+
+    REQUIRE(std::string_view{summary[1].name} == "inner");
+    REQUIRE(summary[1].depth == 1);
+    REQUIRE(summary[1].calls == 3);
+    REQUIRE(summary[1].seconds <= summary[0].seconds);
+
+    // Zones of earlier frames are left out.
+    profiler.begin_frame();
+    REQUIRE(profiler.frame_summary().empty());
+}
+
+TEST_CASE("profiler_t records zones of all threads", "[profiler_t]")
+{
+    profiler_t   profiler;
+    job_system_t jobs{3};
+    profiler.set_enabled(true);
+
+    profiler.begin_frame();
+    jobs.parallel_for(64, 1, [](size_t, size_t) { MAU_PROFILE_ZONE("range"); });
+    profiler.begin_frame();
+
+    const auto* zone = find_zone(profiler, "range");
+    REQUIRE(zone != nullptr);
+    REQUIRE(zone->calls == 64);
+}
+
+TEST_CASE("profiler_t records nothing while disabled", "[profiler_t]")
+{
+    profiler_t profiler;
+
+    profiler.begin_frame();
+    {
+        MAU_PROFILE_ZONE("ignored");
+    }
+    profiler.set_enabled(true);
+    profiler.begin_frame();
+    profiler.begin_frame();
+
+    REQUIRE(profiler.frame_summary().empty());
+}
+
+TEST_CASE("profiler_t exports Chrome traces", "[profiler_t]")
+{
+    static constexpr const char* path_k = "test_profiler_trace.json";
+
+    profiler_t profiler;
+    profiler.set_enabled(true);
+    profiler_t::set_thread_name("test");
+
+    {
+        MAU_PROFILE_ZONE("exported");
+    }
+
+    profiler.save_chrome_trace(path_k);
+
+    std::ifstream     stream{path_k};
+    std::stringstream contents;
+    contents << stream.rdbuf();
+
+    const std::string trace = contents.str();
+    REQUIRE(trace.find("\"traceEvents\"") != std::string::npos);
+    REQUIRE(trace.find("\"name\":\"exported\",\"ph\":\"X\"") != std::string::npos);
+    REQUIRE(trace.find("\"args\":{\"name\":\"test\"}") != std::string::npos);
+
+    stream.close();
+    std::remove(path_k);
+}
@@ -0,0 +1,53 @@
+#include "catch.hpp"
+
+#include <mau/containers/radix_sort.hpp>
+
+#include <algorithm>
+#include <random>
+
+using namespace mau;
+
+TEST_CASE("radix_sort orders entries like a stable sort", "[radix_sort]")
+{
+    std::mt19937 random{42};
+
+    // Keys with only a few bytes in use skip passes, so try those along with full ones.
+    for(uint64_t mask: {0xFFULL, 0xFF00FF0000ULL, 0xFFFF000000000000ULL, ~0ULL})
+    {
+        std::vector<radix_sort_entry_t> entries;
+        for(uint32_t i = 0; i < 1000; ++i)
+        {
+            // Few distinct keys, so there are plenty of ties for stability to show in.
+            const uint64_t key = (static_cast<uint64_t>(random()) << 32 | random()) & mask;
+            entries.push_back({key % 7 == 0 ? 0 : key, i});
+        }
+
+        auto expected = entries;
+        std::stable_sort(expected.begin(), expected.end(), [](const auto& a, const auto& b) { return a.key < b.key; });
+
+        std::vector<radix_sort_entry_t> scratch;
+        radix_sort(entries, scratch);
+
+        REQUIRE(entries.size() == expected.size());
+        for(size_t i = 0; i < entries.size(); ++i)
+        {
+            REQUIRE(entries[i].key == expected[i].key);
+            REQUIRE(entries[i].index == expected[i].index);
+        }
+    }
+}
+
+TEST_CASE("radix_sort handles no and equal entries", "[radix_sort]")
+{
+    std::vector<radix_sort_entry_t> scratch;
+
+    std::vector<radix_sort_entry_t> entries;
+    radix_sort(entries, scratch);
+    REQUIRE(entries.empty());
+
+    entries = {{5, 0}, {5, 1}, {5, 2}};
+    radix_sort(entries, scratch);
+    REQUIRE(entries[0].index == 0);
+    REQUIRE(entries[1].index == 1);
+    REQUIRE(entries[2].index == 2);
+}
@@ -0,0 +1,66 @@
+#include "catch.hpp"
+
+#include <worship/gameplay/replay.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+using namespace mau;
+
+static std::string replay_path()
+{
+    return (std::filesystem::temp_directory_path() / "mau-tests-replay.rec").string();
+}
+
+TEST_CASE("replay_t loads what it saved", "[replay_t]")
+{
+    replay_t replay;
+    replay.seed       = 1234;
+    replay.difficulty = difficulty_t::hard_k;
+    replay.commands   = {{glm::quat{1.0f, 0.0f, 0.0f, 0.0f}, player_buttons::forward_k, 0},
+                       {glm::quat{0.5f, 0.5f, 0.5f, 0.5f}, player_buttons::fire_k | player_buttons::left_k, 2},
+                       {glm::quat{0.0f, 0.0f, 1.0f, 0.0f}, 0, 0}};
+
+    const std::string path = replay_path();
+    replay.save(path);
+
+    const replay_t loaded = replay_t::load(path);
+    std::remove(path.c_str());
+
+    REQUIRE(loaded.seed == replay.seed);
+    REQUIRE(loaded.difficulty == replay.difficulty);
+    REQUIRE(loaded.commands.size() == replay.commands.size());
+    for(size_t i = 0; i < replay.commands.size(); ++i)
+    {
+        REQUIRE(loaded.commands[i].orientation == replay.commands[i].orientation);
+        REQUIRE(loaded.commands[i].buttons == replay.commands[i].buttons);
+        REQUIRE(loaded.commands[i].weapon_slot == replay.commands[i].weapon_slot);
+    }
+}
+
+TEST_CASE("replay_t rejects invalid and truncated files", "[replay_t]")
+{
+    const std::string path = replay_path();
+
+    replay_t replay;
+    replay.commands.resize(10);
+    replay.save(path);
+
+    // Difficulty follows the magic, version and seed.
+    {
+        std::fstream stream{path, std::ios_base::in | std::ios_base::out | std::ios_base::binary};
+        stream.seekp(3 * sizeof(uint32_t));
+
+        const uint32_t difficulty = 7;
+        stream.write(reinterpret_cast<const char*>(&difficulty), sizeof(difficulty));
+    }
+    REQUIRE_THROWS_AS(replay_t::load(path), exception_t);
+
+    replay.save(path);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    REQUIRE_THROWS_AS(replay_t::load(path), exception_t);
+
+    std::remove(path.c_str());
+    REQUIRE_THROWS_AS(replay_t::load(path), exception_t);
+}
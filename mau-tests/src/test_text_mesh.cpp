@@ -0,0 +1,93 @@
+#include "catch.hpp"
+
+#include <mau/rendering/text_mesh.hpp>
+
+using namespace mau;
+
+// Fonts only need a texture once drawn, so these tests go without one.
+static font_handle_t make_font(bool shadow)
+{
+    return std::make_shared<font_t>(nullptr, glm::ivec2{16, 16}, glm::vec2{8, 8}, shadow, false);
+}
+
+static size_t glyph_vertex_count(const font_t& font)
+{
+    std::vector<vertex_t> vertices;
+    font.append_glyph(vertices, {0, 0}, 'a', {1, 1, 1, 1});
+    return vertices.size();
+}
+
+TEST_CASE("glyph_runs_t keeps the vertices of unchanged runs", "[glyph_runs_t]")
+{
+    const font_handle_t font       = make_font(true);
+    const size_t        glyph_size = glyph_vertex_count(*font);
+    const glm::vec4     white      = {1, 1, 1, 1};
+    const glm::vec4     red        = {1, 0, 0, 1};
+
+    glyph_runs_t runs;
+
+    runs.begin(font);
+    runs.add_run({0, 0}, "100", white);
+    runs.add_run({0, 16}, "50", white);
+    REQUIRE(runs.end());
+    REQUIRE(runs.vertices().size() == 5 * glyph_size);
+
+    const std::vector<vertex_t> first_frame = runs.vertices();
+
+    // Same runs, nothing to upload.
+    runs.begin(font);
+    runs.add_run({0, 0}, "100", white);
+    runs.add_run({0, 16}, "50", white);
+    REQUIRE(!runs.end());
+    REQUIRE(runs.vertices().size() == first_frame.size());
+
+    // A changed run is generated anew, the ones before it are kept.
+    runs.begin(font);
+    runs.add_run({0, 0}, "100", white);
+    runs.add_run({0, 16}, "49", red);
+    REQUIRE(runs.end());
+    REQUIRE(runs.vertices().size() == 5 * glyph_size);
+    for(size_t i = 0; i < 3 * glyph_size; ++i)
+        REQUIRE(runs.vertices()[i].position == first_frame[i].position);
+    REQUIRE(runs.vertices()[3 * glyph_size + glyph_size / 2].color == red);
+
+    // Runs added after the kept ones are new vertices too.
+    runs.begin(font);
+    runs.add_run({0, 0}, "100", white);
+    runs.add_run({0, 16}, "49", red);
+    runs.add_run({0, 32}, "7", white);
+    REQUIRE(runs.end());
+    REQUIRE(runs.vertices().size() == 6 * glyph_size);
+
+    // Runs not added again are dropped.
+    runs.begin(font);
+    runs.add_run({0, 0}, "100", white);
+    REQUIRE(runs.end());
+    REQUIRE(runs.vertices().size() == 3 * glyph_size);
+
+    runs.begin(font);
+    REQUIRE(runs.end());
+    REQUIRE(runs.vertices().empty());
+
+    runs.begin(font);
+    REQUIRE(!runs.end());
+}
+
+TEST_CASE("glyph_runs_t starts over when the font changes", "[glyph_runs_t]")
+{
+    const font_handle_t shadowed = make_font(true);
+    const font_handle_t plain    = make_font(false);
+
+    glyph_runs_t runs;
+
+    runs.begin(shadowed);
+    runs.add_run({0, 0}, "FPS", {1, 1, 1, 1});
+    REQUIRE(runs.end());
+    REQUIRE(runs.vertices().size() == 3 * glyph_vertex_count(*shadowed));
+
+    runs.begin(plain);
+    runs.add_run({0, 0}, "FPS", {1, 1, 1, 1});
+    REQUIRE(runs.end());
+    REQUIRE(runs.font() == plain);
+    REQUIRE(runs.vertices().size() == 3 * glyph_vertex_count(*plain));
+}
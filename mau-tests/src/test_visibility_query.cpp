@@ -0,0 +1,93 @@
+#include "catch.hpp"
+
+#include <mau/math/visibility_query.hpp>
+#include <mau/threading/job_system.hpp>
+
+#include <random>
+
+using namespace mau;
+
+// Two 8x8 regions side by side, with a wall along their shared edge which may have a doorway in it.
+static bit_grid_t create_split_grid(bool with_doorway)
+{
+    bit_grid_t grid{{16, 8}};
+    for(int32_t y = 0; y < 8; ++y)
+    {
+        grid.set({7, y}, !with_doorway || y != 4);
+        grid.set({8, y}, !with_doorway || y != 4);
+    }
+    return grid;
+}
+
+TEST_CASE("visibility_query_t culls by both set and view", "[visibility_query_t]")
+{
+    job_system_t jobs{0};
+
+    const potentially_visible_set_t open{create_split_grid(true), 8, jobs};
+    visibility_query_t              query{open};
+
+    // Looking through the doorway.
+    query.begin_frame({2.5f, 4.5f}, {1.0f, 0.0f}, 0.5f);
+
+    REQUIRE(query.visible_regions().size() == 2);
+    REQUIRE(query.region_visible(0));
+    REQUIRE(query.region_visible(1));
+    REQUIRE(query.box_visible({12.0f, 4.0f}, {13.0f, 5.0f}));
+    REQUIRE_FALSE(query.box_visible({2.0f, 0.0f}, {3.0f, 1.0f}));
+    REQUIRE_FALSE(query.region_visible(-1));
+
+    // Turning around must forget about the previous frame's results.
+    const uint32_t previous_frame = query.frame();
+    query.begin_frame({2.5f, 4.5f}, {-1.0f, 0.0f}, 0.5f);
+
+    REQUIRE(query.frame() != previous_frame);
+    REQUIRE(query.visible_regions().size() == 1);
+    REQUIRE(query.region_visible(0));
+    REQUIRE_FALSE(query.region_visible(1));
+    REQUIRE_FALSE(query.box_visible({12.0f, 4.0f}, {13.0f, 5.0f}));
+
+    // Without the doorway, the view ends at the wall.
+    const potentially_visible_set_t closed{create_split_grid(false), 8, jobs};
+    visibility_query_t              closed_query{closed};
+
+    closed_query.begin_frame({2.5f, 4.5f}, {1.0f, 0.0f}, 0.5f);
+
+    REQUIRE(closed_query.region_visible(0));
+    REQUIRE_FALSE(closed_query.region_visible(1));
+}
+
+TEST_CASE("visibility_query_t benchmark", "[visibility_query_t][!benchmark]")
+{
+    static constexpr int32_t grid_size_k = 128;
+    static constexpr int32_t box_count_k = 2048;
+
+    job_system_t jobs{0};
+
+    std::mt19937                          random{1234};
+    std::uniform_real_distribution<float> coordinate{1.0f, grid_size_k - 1.0f};
+
+    // Scattered pillars, leaving most of the level open.
+    bit_grid_t grid{{grid_size_k, grid_size_k}};
+    for(int32_t i = 0; i < grid_size_k * grid_size_k / 16; ++i)
+        grid.set(glm::ivec2{coordinate(random), coordinate(random)}, true);
+
+    const potentially_visible_set_t set{grid, 16, jobs};
+    visibility_query_t              query{set};
+
+    std::vector<glm::vec2> boxes;
+    for(int32_t i = 0; i < box_count_k; ++i)
+        boxes.push_back({coordinate(random), coordinate(random)});
+
+    float angle = 0.0f;
+
+    BENCHMARK("begin_frame and 2048 boxes")
+    {
+        angle += 0.1f;
+        query.begin_frame({64.5f, 64.5f}, {std::cos(angle), std::sin(angle)}, 0.8f);
+
+        int32_t visible = 0;
+        for(const auto& box: boxes)
+            visible += query.box_visible(box - 0.5f, box + 0.5f);
+        return visible;
+    };
+}
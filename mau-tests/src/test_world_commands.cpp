@@ -0,0 +1,269 @@
+#include "catch.hpp"
+
+#include <mau/containers/bit_grid.hpp>
+#include <mau/math/algorithms.hpp>
+#include <worship/gameplay/physics_components.hpp>
+#include <worship/gameplay/world/body_partitions.hpp>
+#include <worship/gameplay/world/world_commands.hpp>
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <random>
+
+using namespace mau;
+
+// Bodies sliding around a walled grid, ticked the way world_t::fixed_update does: updates record changes into the
+// tick's commands in parallel, bodies move partition by partition through body_partitions_t, and the commands are
+// carried out at the end. Moving resolves collisions the way entity_t::move does, axis by axis against walls and other
+// bodies, which are looked up in a spatial index of tiles kept up to date while moving. Collisions record commands, and
+// every body hit by another one splits off a new body placed by the seeded generator, so any change in the order bodies
+// move or commands are applied in shows in the outcome.
+struct test_world_t
+{
+    static constexpr int32_t size_k        = 32;
+    static constexpr int32_t region_size_k = 4;
+    static constexpr size_t  max_bodies_k  = 400;
+    static constexpr size_t  grain_k       = 16;
+    static constexpr float   body_size_k   = 0.5f;
+
+    test_world_t(const bit_grid_t& walls, const potentially_visible_set_t& regions, uint32_t seed) :
+        walls(walls), regions(regions), tiles(size_k * size_k), random(seed)
+    {
+        for(size_t i = 0; i < 100; ++i)
+            spawn();
+    }
+
+    // Places a body in a random open tile, unless there's another one around.
+    void spawn()
+    {
+        std::uniform_int_distribution<int32_t> cell{0, size_k - 1};
+        std::uniform_real_distribution<float>  angle{0.0f, glm::two_pi<float>()};
+        std::uniform_real_distribution<float>  speed{2.0f, 6.0f};
+
+        const glm::ivec2 tile{cell(random), cell(random)};
+        const float      direction = angle(random);
+        const glm::vec3  velocity  = glm::vec3{std::cos(direction), 0.0f, std::sin(direction)} * speed(random);
+
+        if(walls.get(tile) || !tiles[tile.y * size_k + tile.x].empty())
+            return;
+
+        const physics_index_t index = physics.create(nullptr);
+        physics.positions[index]      = {tile.x + 0.5f, 0.5f, tile.y + 0.5f};
+        physics.velocities[index]     = velocity;
+        physics.bounding_boxes[index] = glm::vec3{body_size_k};
+        physics.simulated[index]      = true;
+        insert(index);
+    }
+
+    // Registers the body with the tiles around it, like world_info_t does with entities.
+    void insert(physics_index_t index)
+    {
+        const glm::ivec2 tile = glm::floor(glm::vec2{physics.positions[index].x, physics.positions[index].z});
+
+        for(int32_t y = std::max(tile.y - 1, 0); y <= std::min(tile.y + 1, size_k - 1); ++y)
+        {
+            for(int32_t x = std::max(tile.x - 1, 0); x <= std::min(tile.x + 1, size_k - 1); ++x)
+                tiles[y * size_k + x].push_back(index);
+        }
+    }
+    void remove(physics_index_t index)
+    {
+        const glm::ivec2 tile = glm::floor(glm::vec2{physics.positions[index].x, physics.positions[index].z});
+
+        for(int32_t y = std::max(tile.y - 1, 0); y <= std::min(tile.y + 1, size_k - 1); ++y)
+        {
+            for(int32_t x = std::max(tile.x - 1, 0); x <= std::min(tile.x + 1, size_k - 1); ++x)
+            {
+                auto& bodies = tiles[y * size_k + x];
+                auto  it     = std::find(bodies.begin(), bodies.end(), index);
+                *it          = bodies.back();
+                bodies.pop_back();
+            }
+        }
+    }
+
+    void move(physics_index_t index, float delta_time)
+    {
+        const glm::vec3 amount = physics.velocities[index];
+        const glm::vec3 size   = physics.bounding_boxes[index];
+
+        for(auto i = 0; i < 3; ++i)
+        {
+            remove(index);
+            physics.positions[index][i] += amount[i] * delta_time;
+            insert(index);
+
+            const glm::vec3  position = physics.positions[index];
+            const glm::ivec2 tile     = glm::floor(glm::vec2{position.x, position.z});
+
+            bool collision = false;
+            for(const physics_index_t other: tiles[tile.y * size_k + tile.x])
+            {
+                if(other == index ||
+                   !math::aabb_intersect(position, size, physics.positions[other], physics.bounding_boxes[other]))
+                    continue;
+
+                recording_world_commands()->projectiles.push_back(
+                    {physics.positions[other], glm::quat{1, 0, 0, 0}, projectile_owner_t::monster_k,
+                     projectile_type_t::grenade_k});
+                collision = true;
+                break;
+            }
+
+            for(int32_t y = tile.y - 1; !collision && y <= tile.y + 1; ++y)
+            {
+                for(int32_t x = tile.x - 1; !collision && x <= tile.x + 1; ++x)
+                {
+                    if(walls.get({x, y}) &&
+                       math::aabb_intersect(position, size, glm::vec3{x, 0, y} + 0.5f, glm::vec3{1}))
+                    {
+                        recording_world_commands()->particles.push_back({position, particle_type_t::bullet_hit_k});
+                        collision = true;
+                    }
+                }
+            }
+
+            if(collision)
+            {
+                remove(index);
+                physics.positions[index][i] -= amount[i] * delta_time;
+                insert(index);
+
+                physics.velocities[index][i] = -physics.velocities[index][i];
+            }
+        }
+    }
+
+    void tick(job_system_t& jobs, float delta_time)
+    {
+        physics.save_previous_positions();
+
+        {
+            world_commands_scope_t commands_scope{&tick_commands};
+
+            // Bodies light up every once in a while, each on its own schedule.
+            range_commands.parallel_for(jobs, physics.size(), grain_k, tick_commands, [this](size_t begin, size_t end) {
+                for(size_t i = begin; i < end; ++i)
+                {
+                    if((tick_count + i) % 50 == 0)
+                        recording_world_commands()->lights.push_back({physics.positions[i], glm::vec3{1}, 2.0f});
+                }
+            });
+
+            partitions.partition(physics, regions);
+            partitions.move(jobs, range_commands, tick_commands, [this, delta_time](physics_index_t index) {
+                move(index, delta_time);
+            });
+        }
+
+        // Commands are logged in the order they're carried out in, for comparing.
+        for(const auto& light: tick_commands.lights)
+            applied.push_back(light.position);
+        for(const auto& particle: tick_commands.particles)
+            applied.push_back(particle.position);
+        for(const auto& projectile: tick_commands.projectiles)
+        {
+            applied.push_back(projectile.position);
+
+            if(physics.size() < max_bodies_k)
+                spawn();
+        }
+
+        tick_commands.clear();
+        ++tick_count;
+    }
+
+    const bit_grid_t&                walls;
+    const potentially_visible_set_t& regions;
+
+    // Bodies registered with every tile around the one they're in.
+    std::vector<std::vector<physics_index_t>> tiles;
+
+    std::mt19937           random;
+    physics_components_t   physics;
+    body_partitions_t      partitions;
+    range_world_commands_t range_commands;
+    world_commands_t       tick_commands;
+    std::vector<glm::vec3> applied;
+    size_t                 tick_count{0};
+};
+
+TEST_CASE("body_partitions_t moves bodies deterministically no matter the thread count", "[body_partitions_t]")
+{
+    static constexpr uint32_t seed_k       = 1234;
+    static constexpr size_t   tick_count_k = 300;
+    static constexpr int32_t  size_k       = test_world_t::size_k;
+
+    // Walled in, with pillars all over, so bodies run into walls about as often as into each other.
+    bit_grid_t walls{{size_k, size_k}};
+    for(int32_t y = 0; y < size_k; ++y)
+    {
+        for(int32_t x = 0; x < size_k; ++x)
+        {
+            const bool border = x == 0 || y == 0 || x == size_k - 1 || y == size_k - 1;
+            walls.set({x, y}, border || (x % 5 == 2 && y % 5 == 2));
+        }
+    }
+
+    job_system_t serial_jobs{0};
+    job_system_t parallel_jobs{3};
+
+    const potentially_visible_set_t regions{walls, test_world_t::region_size_k, serial_jobs};
+
+    test_world_t serial{walls, regions, seed_k};
+    test_world_t parallel{walls, regions, seed_k};
+
+    const size_t initial_bodies = serial.physics.size();
+
+    for(size_t tick = 0; tick < tick_count_k; ++tick)
+    {
+        serial.tick(serial_jobs, 1.0f / 60.0f);
+        parallel.tick(parallel_jobs, 1.0f / 60.0f);
+    }
+
+    // Enough happened for a wrong order to show.
+    REQUIRE(serial.physics.size() > initial_bodies + 20);
+    REQUIRE(serial.applied.size() > 500);
+
+    REQUIRE(serial.physics.size() == parallel.physics.size());
+    for(size_t i = 0; i < serial.physics.size(); ++i)
+    {
+        REQUIRE(serial.physics.positions[i] == parallel.physics.positions[i]);
+        REQUIRE(serial.physics.velocities[i] == parallel.physics.velocities[i]);
+    }
+
+    REQUIRE(serial.applied == parallel.applied);
+}
+
+TEST_CASE("range_world_commands_t drops what a failed loop recorded", "[range_world_commands_t]")
+{
+    job_system_t           jobs{2};
+    range_world_commands_t range_commands;
+    world_commands_t       commands;
+
+    const auto record = [](size_t begin, size_t) {
+        recording_world_commands()->particles.push_back({glm::vec3{float(begin)}, particle_type_t::bullet_hit_k});
+    };
+
+    REQUIRE_THROWS_AS(range_commands.parallel_for(jobs,
+                                                  100,
+                                                  10,
+                                                  commands,
+                                                  [&](size_t begin, size_t end) {
+                                                      record(begin, end);
+                                                      if(begin == 50)
+                                                          throw exception_t{"failed"};
+                                                  }),
+                      exception_t);
+    REQUIRE(commands.particles.empty());
+
+    // Nothing from the failed loop turns up with the next one.
+    range_commands.parallel_for(jobs, 100, 10, commands, record);
+    REQUIRE(commands.particles.size() == 10);
+    for(size_t i = 0; i < commands.particles.size(); ++i)
+        REQUIRE(commands.particles[i].position.x == float(i * 10));
+
+    // Recording stops along with the loop.
+    REQUIRE(recording_world_commands() == nullptr);
+}
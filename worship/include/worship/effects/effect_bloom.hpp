@@ -15,16 +15,28 @@ public:
     render_target_handle_t apply(render_target_handle_t pInput) override;
 
 private:
+    // Levels of the pyramid, at a half, a quarter and an eighth of the viewport size.
+    static constexpr size_t level_count_k = 3;
+
+    // Halves the resolution, averaging 2x2 texels.
+    shader_handle_t downsample_shader_m;
+
     // Gaussian blur shader.
     shader_handle_t blur_shader_m;
 
+    // Adds a coarser level onto a finer one.
+    shader_handle_t upsample_shader_m;
+
     // Blending shader.
     shader_handle_t bloom_shader_m;
 
-    // Ping-pong buffers. Since we're doing two passes, and we can't read from and write to the same buffer, we use two
-    // alternating buffers.
-    std::array<render_target_handle_t, 2> blur_render_target_m;
-    render_target_handle_t                result_render_target_m;
+    // Ping-pong buffers per level. Since we're doing two blur passes, and we can't read from and write to the same
+    // buffer, we use two alternating buffers. The first ends up holding the blurred level, the second the level with
+    // all coarser ones added onto it.
+    using level_render_targets_t = std::array<render_target_handle_t, 2>;
+
+    std::array<level_render_targets_t, level_count_k> level_render_targets_m;
+    render_target_handle_t                            result_render_target_m;
 };
 
 } // namespace mau
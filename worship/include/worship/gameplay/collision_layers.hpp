@@ -6,6 +6,9 @@ namespace mau {
 
 using collision_mask_t = uint64_t;
 
+// Handle to a line of sight query made to the world, valid during the tick after the one it was made in.
+using line_of_sight_query_t = uint32_t;
+
 namespace collision_layers {
 
 inline static constexpr collision_mask_t player_k     = 1ULL;
@@ -4,6 +4,8 @@
 
 #include "worship/gameplay/entity_descriptor.hpp"
 
+#include <random>
+
 namespace mau {
 
 class enemy_t : public sprite_entity_t
@@ -36,6 +38,8 @@ private:
     void change_animation(enemy_descriptor_t::animation_t animation);
     void die();
 
+    glm::vec3 random_direction();
+
     const enemy_descriptor_t& descriptor_m;
 
     float health_m;
@@ -49,6 +53,10 @@ private:
     enemy_state_t state_m{enemy_state_t::unaware_k};
     float         state_timer_m{0.0f};
 
+    // Line of sight checks are answered by the world a tick after being made.
+    line_of_sight_query_t sight_query_m{0};
+    bool                  awaiting_sight_m{false};
+
     static constexpr float unaware_interval_k          = 0.25f;
     static constexpr float acquiring_player_interval_k = 0.25f;
     static constexpr float move_duration_k             = 1.0f;
@@ -57,6 +65,10 @@ private:
     float fire_range_m;
 
     glm::vec3 desired_direction_m{};
+    bool      following_path_m{false};
+
+    // Enemies update in parallel, so each draws from its own generator.
+    std::minstd_rand random_m;
 };
 
 } // namespace mau
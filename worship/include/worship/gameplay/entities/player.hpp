@@ -4,6 +4,8 @@
 
 #include "worship/gameplay/weapon.hpp"
 
+#include <random>
+
 namespace mau {
 
 enum class difficulty_t
@@ -23,6 +25,7 @@ public:
     void walk(glm::vec3 direction, float delta_time);
 
     glm::vec3 camera_position() const;
+    glm::vec3 interpolated_camera_position(float alpha) const;
     float     move_acceleration() const;
     float     head_bob() const;
     glm::vec2 weapon_bob() const;
@@ -80,6 +83,9 @@ private:
     // Sounds
     std::vector<audio_clip_handle_t> grunts_m;
     audio_clip_handle_t              death_sound_m;
+
+    // Picks grunts. Damage may be taken while the world moves in parallel, so this can't be shared.
+    std::minstd_rand random_m;
 };
 
 } // namespace mau
@@ -19,11 +19,11 @@ enum class projectile_owner_t
 class projectile_t : public sprite_entity_t
 {
 public:
-    projectile_t(world_t&                world,
-                 glm::vec3               position,
-                 glm::quat               orientation,
-                 projectile_owner_t      owner,
-                 projectile_descriptor_t descriptor);
+    projectile_t(world_t&                       world,
+                 glm::vec3                      position,
+                 glm::quat                      orientation,
+                 projectile_owner_t             owner,
+                 const projectile_descriptor_t& descriptor);
 
     void fixed_update(float delta_time) override;
     void variable_update(float delta_time) override;
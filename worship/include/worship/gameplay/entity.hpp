@@ -2,6 +2,7 @@
 
 #include "worship/gameplay/collision_layers.hpp"
 #include "worship/gameplay/event_callback.hpp"
+#include "worship/gameplay/physics_components.hpp"
 
 #include "mau/rendering/renderer.hpp"
 
@@ -24,13 +25,20 @@ public:
 
     virtual void fixed_update(float delta_time);
     virtual void variable_update(float delta_time);
-    virtual void render(renderer_t& renderer, shader_handle_t ubershader, float delta_time);
+    virtual void render(renderer_t&       renderer,
+                        shader_handle_t   ubershader,
+                        shader_features_t features,
+                        float             delta_time);
 
     virtual void on_collision(entity_t& entity);
     virtual void on_wall_collision();
 
     virtual void destroy();
 
+    // Resolves movement by the given amount against walls and other entities. Called by the world for every simulated
+    // entity after gravity is integrated.
+    void move(glm::vec3 amount, float delta_time);
+
     // Applies acceleration based on mass. Use only from within fixed update!
     void apply_force(glm::vec3 force, float delta_time);
 
@@ -38,9 +46,13 @@ public:
     void rotate(float degrees, glm::vec3 axis);
 
     glm::vec3        position() const;
+    glm::vec3        interpolated_position(float alpha) const;
     glm::quat        orientation() const;
+    glm::vec3        velocity() const;
     glm::vec3        bounding_box() const;
+    float            bounciness() const;
     bool             blocking() const;
+    bool             simulated() const;
     collision_mask_t collision_layer() const;
     collision_mask_t collision_mask() const;
 
@@ -50,42 +62,37 @@ public:
 
     bool destroyed() const;
 
+    // Frame of the world's visibility pass which last found this entity visible.
+    uint32_t visible_frame() const;
+    void     set_visible_frame(uint32_t frame);
+
     void set_position(glm::vec3 position);
     void set_orientation(glm::quat orientation);
+    void set_velocity(glm::vec3 velocity);
+    void set_bounding_box(glm::vec3 bounding_box);
     void set_friction(float friction);
+    void set_bounciness(float bounciness);
+    void set_gravity(bool gravity);
     void set_blocking(bool blocking);
+    void set_simulated(bool simulated);
     void set_collision_layer(collision_mask_t collision_layer);
     void set_collision_mask(collision_mask_t collision_mask);
 
 private:
-    // This should never be modified without accoringly taking care of spatial structures.
-    glm::vec3 position_m{0, 0, 0};
+    friend struct physics_components_t;
 
-protected:
-    void move(glm::vec3 amount, float delta_time);
+    // Index of this entity's physics state within the world's component arrays. Position in particular should never be
+    // modified without accordingly taking care of spatial structures.
+    physics_index_t physics_index_m;
 
+protected:
     world_t& world_m;
 
     glm::quat orientation_m{1, 0, 0, 0};
-    glm::vec3 velocity_m{0, 0, 0};
-    glm::vec3 bounding_box_m{1, 1, 1}; // Bounding box size used for collision detection.
-
-    float mass_m{1.0f};
-    float friction_m{0.0f};
-    float bounciness_m{0.0f};
-    bool  gravity_m{false};
 
     bool destroyed_m{false};
 
-    // Whether or not prevent movement when collided with.
-    bool blocking_m{false};
-
-    // Mask which indicates which layer the object is on.
-    collision_mask_t collision_layer_m{0};
-
-    // Mask which indicates which objects will block movement for this object, or for which on_collision() will be called. In
-    // short, this mask is a list of layer we want to check collision against.
-    collision_mask_t collision_mask_m{0};
+    uint32_t visible_frame_m{0};
 };
 
 } // namespace mau
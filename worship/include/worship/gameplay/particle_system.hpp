@@ -0,0 +1,61 @@
+#pragma once
+
+#include "worship/gameplay/entity_descriptor.hpp"
+
+#include <mau/rendering/renderer.hpp>
+
+#include <vector>
+
+namespace mau {
+
+// World-wide particle storage. Particles are grouped into batches by texture and stored as separate arrays per component,
+// so they can be integrated four at a time. Every frame all live particles are streamed into one shared vertex object and
+// drawn with a single call per batch. Dead particles are compacted away rather than kept around invisible.
+class particle_system_t : non_copyable_t, non_movable_t
+{
+public:
+    particle_system_t();
+
+    // Spawn a burst of particles around the position, as described by the descriptor.
+    void emit(glm::vec3 position, const particle_descriptor_t& descriptor);
+
+    void update(float delta_time);
+    // Draws with a particle variant of the ubershader, leaving it bound.
+    void render(renderer_t& renderer, shader_handle_t ubershader, shader_features_t features);
+
+    size_t size() const;
+
+private:
+    struct batch_t
+    {
+        size_t count() const;
+
+        // Removes particle by moving the last one into its place.
+        void remove(size_t index);
+
+        texture_handle_t texture_diffuse;
+        texture_handle_t texture_emission;
+
+        std::vector<float>     position_x;
+        std::vector<float>     position_y;
+        std::vector<float>     position_z;
+        std::vector<float>     velocity_x;
+        std::vector<float>     velocity_y;
+        std::vector<float>     velocity_z;
+        std::vector<float>     gravity_x;
+        std::vector<float>     gravity_y;
+        std::vector<float>     gravity_z;
+        std::vector<float>     life;
+        std::vector<float>     size;
+        std::vector<glm::vec4> color;
+    };
+
+    batch_t& batch(const particle_descriptor_t& descriptor);
+
+    std::vector<batch_t> batches_m;
+
+    std::vector<vertex_t>  vertices_m;
+    vertex_object_handle_t vertex_object_m;
+};
+
+} // namespace mau
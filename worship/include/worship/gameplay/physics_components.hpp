@@ -0,0 +1,50 @@
+#pragma once
+
+#include "worship/gameplay/collision_layers.hpp"
+
+#include <mau/base/types.hpp>
+#include <mau/math/vector.hpp>
+
+#include <vector>
+
+namespace mau {
+
+class entity_t;
+
+using physics_index_t = uint32_t;
+
+// Physics state of all entities, stored as parallel arrays indexed by the entity's physics index. Integration passes run
+// as tight loops over these instead of going through each entity. Removal swaps the last body into the freed slot, so
+// the arrays always stay densely packed.
+struct physics_components_t : non_copyable_t, non_movable_t
+{
+    physics_index_t create(entity_t* owner);
+    void            destroy(physics_index_t index);
+
+    size_t size() const;
+
+    // Applies gravity to every body which has it enabled. Use only from within fixed update!
+    void integrate_gravity(float delta_time);
+
+    // Applies friction to every body.
+    void apply_friction();
+
+    // Remembers where bodies are at the start of a tick, for rendering them in between ticks.
+    void save_previous_positions();
+
+    std::vector<entity_t*>        owners;
+    std::vector<glm::vec3>        positions;
+    std::vector<glm::vec3>        previous_positions;
+    std::vector<glm::vec3>        velocities;
+    std::vector<glm::vec3>        bounding_boxes;
+    std::vector<float>            masses;
+    std::vector<float>            frictions;
+    std::vector<float>            bouncinesses;
+    std::vector<uint8_t>          gravities;
+    std::vector<uint8_t>          blocking;
+    std::vector<uint8_t>          simulated;
+    std::vector<collision_mask_t> layer_masks;
+    std::vector<collision_mask_t> collision_masks;
+};
+
+} // namespace mau
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "worship/gameplay/entities/player.hpp"
+
+#include <mau/base/types.hpp>
+#include <mau/math/quaternion.hpp>
+
+#include <string>
+#include <vector>
+
+namespace mau {
+
+namespace player_buttons {
+
+inline static constexpr uint8_t forward_k  = 1U;
+inline static constexpr uint8_t backward_k = 1U << 1;
+inline static constexpr uint8_t left_k     = 1U << 2;
+inline static constexpr uint8_t right_k    = 1U << 3;
+inline static constexpr uint8_t fire_k     = 1U << 4;
+
+} // namespace player_buttons
+
+// Everything the player did during a single tick. Ticks are simulated from these alone, so the same commands replay
+// the same session, given the same seed.
+struct player_command_t
+{
+    // Turning is applied every frame so it feels responsive, and ticks only take the resulting orientation.
+    glm::quat orientation{};
+    uint8_t   buttons{0};
+
+    // Weapon slot picked since the previous tick, zero for none.
+    uint8_t weapon_slot{0};
+};
+
+// Recording of a gameplay session, one command per tick.
+struct replay_t
+{
+    // Both throw on failure.
+    static replay_t load(const std::string& path);
+    void            save(const std::string& path) const;
+
+    uint32_t     seed{0};
+    difficulty_t difficulty{difficulty_t::normal_k};
+
+    std::vector<player_command_t> commands;
+};
+
+} // namespace mau
@@ -10,7 +10,10 @@ public:
     sprite_entity_t(world_t& world, glm::vec3 position);
     virtual ~sprite_entity_t();
 
-    void render(renderer_t& renderer, shader_handle_t ubershader, float delta_time) override;
+    void render(renderer_t&       renderer,
+                shader_handle_t   ubershader,
+                shader_features_t features,
+                float             delta_time) override;
 
     virtual texture_handle_t sprite_texture_diffuse();
     virtual texture_handle_t sprite_texture_emission();
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "worship/gameplay/physics_components.hpp"
+#include "worship/gameplay/world/world_commands.hpp"
+
+#include <mau/math/potentially_visible_set.hpp>
+#include <mau/threading/job_system.hpp>
+
+#include <functional>
+#include <vector>
+
+namespace mau {
+
+// Moves simulated bodies in parallel where they can't reach each other. Bodies are grouped into partitions by the
+// region they're in, and regions are colored in a 2x2 pattern. Regions of one color are a whole region apart, so bodies
+// in them can't reach each other while moving, and the partitions of a color move in parallel. Colors move one after
+// another, and bodies off the map come last, in one partition of their own.
+class body_partitions_t : non_copyable_t, non_movable_t
+{
+public:
+    using move_function_t = std::function<void(physics_index_t index)>;
+
+    // Groups simulated bodies into partitions by the region of the set they're in. Bodies of a partition keep their
+    // physics order.
+    void partition(const physics_components_t& physics, const potentially_visible_set_t& regions);
+
+    // Calls the function for every partitioned body, recording world changes into the commands. Commands come out in
+    // the same order no matter how many threads moved the bodies.
+    void move(job_system_t&           jobs,
+              range_world_commands_t& range_commands,
+              world_commands_t&       commands,
+              const move_function_t&  function);
+
+private:
+    uint32_t region_total_m{0};
+
+    // Bodies sorted by partition, along with the offset of each partition. Partitions are keyed by color first and
+    // region second, so every color is a contiguous run of partitions.
+    std::vector<physics_index_t> bodies_m;
+    std::vector<uint32_t>        offsets_m;
+    std::vector<uint32_t>        keys_m;
+    std::vector<uint32_t>        busy_partitions_m;
+};
+
+} // namespace mau
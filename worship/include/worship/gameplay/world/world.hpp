@@ -1,50 +1,87 @@
 #pragma once
 
 #include "worship/gameplay/entities/player.hpp"
+#include "worship/gameplay/entities/projectile.hpp"
 #include "worship/gameplay/event_callback.hpp"
+#include "worship/gameplay/particle_system.hpp"
+#include "worship/gameplay/world/body_partitions.hpp"
 #include "worship/gameplay/world/world_chunk.hpp"
+#include "worship/gameplay/world/world_commands.hpp"
 
 #include <mau/audio/audio_clip.hpp>
 #include <mau/base/types.hpp>
+#include <mau/containers/bit_grid.hpp>
+#include <mau/containers/radix_sort.hpp>
+#include <mau/math/flow_field.hpp>
+#include <mau/math/potentially_visible_set.hpp>
+#include <mau/math/visibility_query.hpp>
 #include <mau/math/vector.hpp>
+#include <mau/memory/object_pool.hpp>
+#include <mau/rendering/pass_constants.hpp>
 #include <mau/rendering/shader.hpp>
 #include <mau/rendering/texture.hpp>
 
+#include <functional>
 #include <optional>
-#include <set>
-#include <unordered_map>
-#include <unordered_set>
+#include <random>
 #include <vector>
 
 namespace mau {
 
 class engine_context_t;
 
-struct dynamic_light_t
+// Entities may either be heap allocated or come from one of the world's pools. The deleter knows which one it is and
+// hands pooled entities back to their pool.
+struct entity_deleter_t
 {
-    glm::vec3 position{};
-    glm::vec3 color{};
-    float     radius{};
-    bool      destroyed{false};
+    using release_function_t = void (*)(void* pool, entity_t* entity);
+
+    void operator()(entity_t* entity) const;
+
+    void*              pool{nullptr};
+    release_function_t release{nullptr};
 };
 
+using entity_handle_t = std::unique_ptr<entity_t, entity_deleter_t>;
+
 class world_t : non_copyable_t, non_movable_t
 {
 public:
-    world_t(engine_context_t& engine, event_callback_t& event_callback, difficulty_t difficulty);
+    // Everything random in the world follows from the seed, so the same seed and player input play out the same.
+    world_t(engine_context_t& engine, event_callback_t& event_callback, difficulty_t difficulty, uint32_t seed);
 
     void fixed_update(float delta_time);
     void variable_update(float delta_time);
-    void render(float delta_time, shader_handle_t ubershader, const glm::mat4& projection, const glm::mat4& view);
+    // Draws with variants of the ubershader specialized for the given features, plus lighting if it's enabled. Lights
+    // are filled into the given pass constants.
+    void render(float delta_time, shader_handle_t ubershader, shader_features_t features, pass_constants_t constants);
+
+    engine_context_t&     engine();
+    event_callback_t&     event_callback();
+    physics_components_t& physics();
 
-    engine_context_t& engine();
-    event_callback_t& event_callback();
+    // Fraction of a tick passed since the latest one, as of the latest variable update. Rendered entities are
+    // interpolated between the positions they had before and after it, so movement stays smooth at frame rates above
+    // the tick rate. Holds still while the world is paused, and so do the entities.
+    float interpolation_alpha() const;
 
     tile_info_t* tile(glm::ivec2 tile_position);
 
-    void             add_entity(std::unique_ptr<entity_t> entity);
+    // Entities added during the tick join the world at its end. Must not be constructed within parallel parts of it.
+    void add_entity(std::unique_ptr<entity_t> entity);
+
+    // Lights added during the tick are deferred until its end, in which case nullptr is returned.
     dynamic_light_t* add_dynamic_light(dynamic_light_t light);
 
+    // Spawn projectile from the pool. Deferred during the tick, like lights.
+    projectile_t* spawn_projectile(glm::vec3          position,
+                                   glm::quat          orientation,
+                                   projectile_owner_t owner,
+                                   projectile_type_t  type);
+
+    // Emit a burst of particles into the world's particle system. Deferred during the tick.
+    void spawn_particles(glm::vec3 position, particle_type_t type);
+
     void spatial_entity_insert(entity_t* entity);
     void spatial_entity_remove(entity_t* entity);
 
@@ -59,21 +96,42 @@ public:
                                      entity_t* ignore_entity,
                                      entity_t** hit_entity);
 
-    // Raycast just walls, keeping track of visited chunks and entities.
-    std::optional<glm::vec3> raycast_walls(glm::vec3                       position,
-                                           glm::vec3                       direction,
-                                           std::unordered_set<glm::ivec2>* visited_chunks,
-                                           std::set<entity_t*>*            visited_entities);
+    // Raycast just walls, appending entities on visited tiles. Entities spanning several tiles are appended repeatedly.
+    std::optional<glm::vec3> raycast_walls(glm::vec3               position,
+                                           glm::vec3               direction,
+                                           std::vector<entity_t*>* visited_entities);
 
     // Raycast just specified entities.
-    std::optional<glm::vec3> raycast_entities(std::set<entity_t*>& entities,
-                                              glm::vec3            position,
-                                              glm::vec3            direction,
-                                              uint64_t             collision_mask,
-                                              entity_t**           hit_entity);
+    std::optional<glm::vec3> raycast_entities(const std::vector<entity_t*>& entities,
+                                              glm::vec3                     position,
+                                              glm::vec3                     direction,
+                                              uint64_t                      collision_mask,
+                                              entity_t**                    hit_entity);
+
+    // Queue a raycast to be resolved at the end of the tick, along with all other queries made during it. Meant for
+    // checks which can wait a tick, such as AI looking out for the player. The query is written once it's queued, which
+    // happens by the end of the tick at the latest.
+    void query_line_of_sight(glm::vec3              position,
+                             glm::vec3              direction,
+                             collision_mask_t       collision_mask,
+                             entity_t*              ignore_entity,
+                             line_of_sight_query_t* query);
+
+    // Entity hit by a query made during the previous tick, or nullptr if a wall was hit first.
+    entity_t* line_of_sight_hit(line_of_sight_query_t query) const;
+
+    // Direction leading towards the player around walls, or zero if there's no way from the position.
+    glm::vec3 navigation_direction(glm::vec3 position) const;
+
+    // Returns true if the entity was found visible while rendering the latest frame.
+    bool entity_visible(const entity_t& entity) const;
 
     player_t* player();
 
+    // Seeds for the random generators of entities, so random behaviour doesn't depend on the order entities update in.
+    uint32_t next_random_seed();
+
+    // Sounds are deferred during the tick as well.
     void play_sound(audio_clip_handle_t clip);
     void play_sound_at(audio_clip_handle_t clip, glm::vec3 position);
 
@@ -84,20 +142,94 @@ public:
 private:
     glm::ivec2 chunk_position(glm::ivec2 tile_position);
 
+    // Runs the function over the ranges in parallel, recording world changes into the tick's commands.
+    void parallel_for_deferred(size_t count, size_t grain, const job_system_t::range_function_t& function);
+
+    // Carries out the commands recorded during the tick.
+    void apply_commands();
+
+    // Removes destroyed entities, taking them out of the spatial index in one go.
+    void remove_destroyed_entities();
+
+    void move_bodies(float delta_time);
+
+    void resolve_line_of_sight();
+
+    // Picks the nearer of the wall hit and the entities gathered into the raycast scratch list.
+    std::optional<glm::vec3> nearest_raycast_hit(glm::vec3                position,
+                                                 glm::vec3                direction,
+                                                 std::optional<glm::vec3> hit_wall,
+                                                 collision_mask_t         collision_mask,
+                                                 entity_t*                ignore_entity,
+                                                 entity_t**               hit_entity);
+
+    template<typename T, size_t BlockSize, typename... Args>
+    T* spawn_pooled(object_pool_t<T, BlockSize>& pool, Args&&... args);
+
     engine_context_t& engine_m;
     event_callback_t& event_callback_m;
 
-    world_info_t                            world_info_m;
-    std::unordered_map<glm::ivec2, chunk_t> chunks_m;
+    world_info_t world_info_m;
+
+    // Walls never change, so chunk visibility is precomputed once the level is loaded. Chunks are indexed by region.
+    bit_grid_t                opaque_tiles_m;
+    potentially_visible_set_t visibility_m;
+    visibility_query_t        visibility_query_m;
+    std::vector<chunk_t>      chunks_m;
+    vertex_object_handle_t    chunk_geometry_m;
+
+    // Ways towards the player's tile, searched again whenever the player enters another tile.
+    flow_field_t navigation_m;
 
     texture_handle_t tileset_texture_diffuse_m;
     texture_handle_t tileset_texture_emission_m;
     texture_handle_t wireframe_texture_m;
 
-    std::vector<std::unique_ptr<entity_t>> entities_m;
-    player_t*                              player_m{nullptr};
+    // Declared ahead of the entities, since they release their physics state and pool slots on destruction.
+    physics_components_t           physics_m;
+    object_pool_t<projectile_t>    projectile_pool_m;
+    object_pool_t<dynamic_light_t> dynamic_light_pool_m;
+
+    std::vector<entity_handle_t> entities_m;
+    player_t*                    player_m{nullptr};
+
+    // Scratch lists reused across frames and raycasts, so neither has to allocate once they've grown.
+    std::vector<entity_t*> visible_entities_m;
+    std::vector<entity_t*> raycast_entities_m;
+
+    // Visible chunks ordered front to back, and their vertex ranges.
+    std::vector<radix_sort_entry_t> visible_chunks_m;
+    std::vector<radix_sort_entry_t> visible_chunks_scratch_m;
+    std::vector<int32_t>            chunk_firsts_m;
+    std::vector<int32_t>            chunk_counts_m;
+
+    struct line_of_sight_request_t
+    {
+        glm::vec3        position;
+        glm::vec3        direction;
+        collision_mask_t collision_mask;
+        entity_t*        ignore_entity;
+    };
+
+    // Line of sight queries of the current tick, and results of the previous one.
+    std::vector<line_of_sight_request_t> line_of_sight_requests_m;
+    std::vector<entity_t*>               line_of_sight_hits_m;
+
+    std::vector<dynamic_light_t*> dynamic_lights_m;
+
+    // Simulated bodies grouped by chunk, so bodies in chunks apart from each other move in parallel.
+    body_partitions_t      body_partitions_m;
+    range_world_commands_t range_commands_m;
+    world_commands_t       tick_commands_m;
+
+    // Scratch list for removing destroyed entities.
+    std::vector<entity_t*> destroyed_entities_m;
+
+    std::mt19937 random_m;
+
+    float interpolation_alpha_m{1.0f};
 
-    std::vector<std::unique_ptr<dynamic_light_t>> dynamic_lights_m;
+    particle_system_t particle_system_m;
 
     vertex_object_handle_t wireframe_cube_m;
 
@@ -5,6 +5,8 @@
 
 #include "worship/gameplay/world/world_info.hpp"
 
+#include <vector>
+
 namespace mau {
 
 class world_t;
@@ -12,14 +14,21 @@ class world_t;
 struct chunk_t
 {
 public:
-    chunk_t(world_t& world, glm::ivec2 position);
+    // Appends the chunk's geometry to the vertices. Chunks of a world share one vertex object, where each chunk is a
+    // range of vertices.
+    chunk_t(world_t& world, glm::ivec2 position, std::vector<vertex_t>& vertices);
+
+    int32_t first() const;
+    int32_t count() const;
 
-    vertex_object_handle_t vertex_object() const;
+    // Center of the chunk's floor, in world space.
+    glm::vec3 center() const;
 
 private:
-    world_t&               world_m;
-    glm::ivec2             position_m;
-    vertex_object_handle_t vertex_object_m;
+    world_t&   world_m;
+    glm::ivec2 position_m;
+    int32_t    first_m{0};
+    int32_t    count_m{0};
 };
 
 } // namespace mau
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "worship/gameplay/entities/projectile.hpp"
+#include "worship/gameplay/particle_system.hpp"
+
+#include <mau/audio/audio_clip.hpp>
+#include <mau/base/types.hpp>
+#include <mau/math/vector.hpp>
+#include <mau/threading/job_system.hpp>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace mau {
+
+struct dynamic_light_t
+{
+    glm::vec3 position{};
+    glm::vec3 color{};
+    float     radius{};
+    bool      destroyed{false};
+};
+
+// World changes requested during the tick, applied in one batch at its end. Nothing the tick iterates over changes
+// under its hands that way. Parallel parts of the tick record into a buffer per partition, which are appended in
+// partition order, so the outcome doesn't depend on which thread ran what.
+struct world_commands_t
+{
+    struct projectile_spawn_t
+    {
+        glm::vec3          position;
+        glm::quat          orientation;
+        projectile_owner_t owner;
+        projectile_type_t  type;
+    };
+
+    struct particle_spawn_t
+    {
+        glm::vec3       position;
+        particle_type_t type;
+    };
+
+    struct sound_t
+    {
+        audio_clip_handle_t      clip;
+        std::optional<glm::vec3> position;
+    };
+
+    struct line_of_sight_t
+    {
+        glm::vec3              position;
+        glm::vec3              direction;
+        collision_mask_t       collision_mask;
+        entity_t*              ignore_entity;
+        line_of_sight_query_t* query;
+    };
+
+    // Moves the commands over, leaving the other buffer empty.
+    void append(world_commands_t& commands);
+    void clear();
+
+    std::vector<std::unique_ptr<entity_t>> entities;
+    std::vector<projectile_spawn_t>        projectiles;
+    std::vector<particle_spawn_t>          particles;
+    std::vector<sound_t>                   sounds;
+    std::vector<dynamic_light_t>           lights;
+    std::vector<line_of_sight_t>           line_of_sight_queries;
+};
+
+// Command buffer the current thread records world changes into, or nullptr if changes take effect right away.
+world_commands_t* recording_world_commands();
+
+// Points the current thread's recording at a buffer for as long as it lives.
+class world_commands_scope_t : non_copyable_t, non_movable_t
+{
+public:
+    explicit world_commands_scope_t(world_commands_t* commands);
+    ~world_commands_scope_t();
+
+private:
+    world_commands_t* previous_m;
+};
+
+// Command buffers for the ranges of parallel loops, kept around so their memory is reused from loop to loop.
+class range_world_commands_t : non_copyable_t, non_movable_t
+{
+public:
+    // Runs the function over the ranges in parallel, recording world changes into a buffer per range. Buffers are
+    // appended to the commands in range order afterwards. If the function throws, whatever the loop recorded is dropped
+    // and the exception rethrown.
+    void parallel_for(job_system_t&                         jobs,
+                      size_t                                count,
+                      size_t                                grain,
+                      world_commands_t&                     commands,
+                      const job_system_t::range_function_t& function);
+
+private:
+    std::vector<world_commands_t> buffers_m;
+};
+
+} // namespace mau
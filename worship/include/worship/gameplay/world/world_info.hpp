@@ -4,6 +4,7 @@
 #include <mau/math/vector.hpp>
 
 #include <set>
+#include <vector>
 
 namespace mau {
 
@@ -66,7 +67,8 @@ struct tile_info_t
     tile_texture_t texture_ceiling;
     glm::vec3      lighting;
 
-    std::set<entity_t*> entities;
+    // Kept as a vector so spatial updates reuse storage instead of allocating tree nodes on every move.
+    std::vector<entity_t*> entities;
 };
 
 enum class object_type_t : uint8_t
@@ -120,6 +122,10 @@ public:
     void add_entity(entity_t* entity);
     void remove_entity(entity_t* entity);
 
+    // Removes all of the entities, which must have been destroyed. Each tile is swept once, no matter how many of them
+    // it holds.
+    void remove_destroyed_entities(const std::vector<entity_t*>& entities);
+
     glm::ivec2 size() const;
 
     void perform_radiosity(glm::ivec2 tile_position, glm::vec3 light_source);
@@ -129,6 +135,9 @@ private:
 
     std::vector<tile_info_t>   tile_info_m;
     std::vector<object_info_t> object_info_m;
+
+    // Tiles to be swept of destroyed entities, reused across removals.
+    std::vector<size_t> swept_tiles_m;
 };
 
 } // namespace mau
@@ -4,19 +4,28 @@
 #include "worship/gameplay/entities/player.hpp"
 #include "worship/gameplay/event_callback.hpp"
 #include "worship/gameplay/messages.hpp"
+#include "worship/gameplay/replay.hpp"
 #include "worship/gameplay/screen_flash.hpp"
 #include "worship/gameplay/world/world.hpp"
 
 #include <mau/base/state.hpp>
+#include <mau/profiling/profiler.hpp>
 #include <mau/rendering/font.hpp>
 #include <mau/rendering/render_target.hpp>
 #include <mau/rendering/shader.hpp>
+#include <mau/rendering/text_mesh.hpp>
+
+#include <optional>
 
 namespace mau {
 class state_gameplay_t : public state_t
 {
 public:
-    explicit state_gameplay_t(engine_context_t& engine, difficulty_t difficulty);
+    // Plays back the replay if one is given, at its difficulty, and records the session otherwise.
+    explicit state_gameplay_t(engine_context_t&       engine,
+                              difficulty_t            difficulty,
+                              std::optional<replay_t> replay = std::nullopt);
+    ~state_gameplay_t() override;
 
     virtual void                   handle_event(const SDL_Event& event) override;
     virtual void                   fixed_update(float delta_time) override;
@@ -28,6 +37,13 @@ public:
     void flash_screen(screen_flash_t screen_flash);
 
 private:
+    // Reads the player's input for the coming tick.
+    player_command_t sample_command();
+    void             apply_command(const player_command_t& command, float delta_time);
+
+    void report_timedemo();
+    void add_profile_text(renderer_t& renderer);
+
     event_callback_t event_callback_m;
 
     render_target_handle_t scene_render_target_m;
@@ -38,6 +54,25 @@ private:
     font_handle_t font_medium_m;
     font_handle_t font_large_m;
 
+    // Number shown on the status bar, formatted again only when it changes.
+    struct status_number_t
+    {
+        std::string_view format(int32_t value);
+
+        std::optional<int32_t> value;
+        std::string            text;
+    };
+
+    // Health, armor and ammo, drawn together as one mesh.
+    status_number_t health_text_m;
+    status_number_t armor_text_m;
+    status_number_t ammo_text_m;
+    text_mesh_t     status_text_m;
+
+    // Game messages, and the debug text along with the profile overlay.
+    text_mesh_t message_text_m;
+    text_mesh_t debug_text_m;
+
     texture_handle_t gui_indicator_health_m;
     texture_handle_t gui_indicator_armor_m;
     texture_handle_t gui_screen_flash_texture_m;
@@ -53,6 +88,23 @@ private:
     screen_flash_t          screen_flash_m{screen_flash_t::none_k};
     timer_t                 screen_flash_timer_m;
 
+    // Per zone breakdown of frames, toggled with F3. Refreshed a few times a second, so it stays readable.
+    bool                                show_profile_m{false};
+    timer_t                             profile_refresh_timer_m;
+    std::vector<profile_zone_summary_t> shown_profile_m;
+
+    // Commands recorded so far, or being played back.
+    replay_t replay_m;
+    bool     playing_back_m;
+    size_t   replay_cursor_m{0};
+    bool     timedemo_finished_m{false};
+    uint8_t  selected_weapon_slot_m{0};
+
+    // Frame and tick times of the playback, in microseconds.
+    timer_t               frame_timer_m;
+    std::vector<uint64_t> frame_times_m;
+    std::vector<uint64_t> tick_times_m;
+
     world_t   world_m;
     player_t* player_m;
 };
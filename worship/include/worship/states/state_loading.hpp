@@ -7,13 +7,19 @@
 #include <mau/rendering/shader.hpp>
 
 #include "worship/gameplay/entities/player.hpp"
+#include "worship/gameplay/replay.hpp"
+
+#include <optional>
 
 namespace mau {
 
 class state_loading_t : public state_t
 {
 public:
-    explicit state_loading_t(engine_context_t& engine, difficulty_t difficulty);
+    // The replay, if any, is handed over to gameplay for playback.
+    explicit state_loading_t(engine_context_t&       engine,
+                             difficulty_t            difficulty,
+                             std::optional<replay_t> replay = std::nullopt);
 
     virtual void                   handle_event(const SDL_Event& event) override;
     virtual void                   fixed_update(float delta_time) override;
@@ -27,6 +33,8 @@ private:
     texture_handle_t       background_m;
     difficulty_t           difficulty_m;
 
+    std::optional<replay_t> replay_m;
+
     uint64_t delay_counter_m{0};
 };
 
@@ -0,0 +1,94 @@
+#include "worship/gameplay/world/body_partitions.hpp"
+
+#include <mau/profiling/profiler.hpp>
+
+#include <limits>
+
+namespace mau {
+
+// Regions are colored in a 2x2 pattern, so that regions of the same color never touch.
+static constexpr uint32_t partition_color_count_k = 4;
+
+void body_partitions_t::partition(const physics_components_t& physics, const potentially_visible_set_t& regions)
+{
+    static constexpr uint32_t unpartitioned_k = std::numeric_limits<uint32_t>::max();
+
+    const glm::ivec2 region_count    = regions.region_count();
+    const uint32_t   off_map_key     = partition_color_count_k * region_count.x * region_count.y;
+    const uint32_t   partition_count = off_map_key + 1;
+
+    region_total_m = region_count.x * region_count.y;
+
+    // Counting sort, which keeps bodies of a partition in physics order. Counts are shifted by two, so that placing the
+    // bodies leaves each offset at the start of its partition.
+    keys_m.resize(physics.size());
+    offsets_m.assign(partition_count + 2, 0);
+
+    for(size_t i = 0; i < physics.size(); ++i)
+    {
+        uint32_t key = unpartitioned_k;
+
+        if(physics.simulated[i])
+        {
+            const glm::vec3 position = physics.positions[i];
+            const int32_t   region   = regions.region_index(glm::floor(glm::vec2{position.x, position.z}));
+
+            if(region < 0)
+                key = off_map_key;
+            else
+            {
+                const glm::ivec2 region_position = regions.region_position(region);
+                const uint32_t   color           = (region_position.x & 1) | ((region_position.y & 1) << 1);
+
+                key = color * region_total_m + region;
+            }
+
+            ++offsets_m[key + 2];
+        }
+
+        keys_m[i] = key;
+    }
+
+    for(uint32_t partition = 2; partition < offsets_m.size(); ++partition)
+        offsets_m[partition] += offsets_m[partition - 1];
+
+    bodies_m.resize(offsets_m.back());
+    for(size_t i = 0; i < physics.size(); ++i)
+    {
+        if(keys_m[i] != unpartitioned_k)
+            bodies_m[offsets_m[keys_m[i] + 1]++] = static_cast<physics_index_t>(i);
+    }
+
+    offsets_m.pop_back();
+}
+void body_partitions_t::move(job_system_t&           jobs,
+                             range_world_commands_t& range_commands,
+                             world_commands_t&       commands,
+                             const move_function_t&  function)
+{
+    for(uint32_t color = 0; color <= partition_color_count_k; ++color)
+    {
+        const uint32_t first = color * region_total_m;
+        const uint32_t last  = color < partition_color_count_k ? first + region_total_m : first + 1;
+
+        busy_partitions_m.clear();
+        for(uint32_t partition = first; partition < last; ++partition)
+        {
+            if(offsets_m[partition + 1] > offsets_m[partition])
+                busy_partitions_m.push_back(partition);
+        }
+
+        range_commands.parallel_for(jobs, busy_partitions_m.size(), 1, commands, [&](size_t begin, size_t end) {
+            MAU_PROFILE_ZONE("move_partition");
+
+            for(size_t i = begin; i < end; ++i)
+            {
+                const uint32_t partition = busy_partitions_m[i];
+                for(uint32_t body = offsets_m[partition]; body < offsets_m[partition + 1]; ++body)
+                    function(bodies_m[body]);
+            }
+        });
+    }
+}
+
+} // namespace mau
@@ -1,66 +1,75 @@
 #include "worship/effects/effect_bloom.hpp"
 
+#include <mau/profiling/profiler.hpp>
+
 namespace mau {
 
 effect_bloom_t::effect_bloom_t(engine_context_t& engine) :
     effect_t(engine),
+    downsample_shader_m(engine.resource_cache().resource<shader_t>("downsample.sha")),
     blur_shader_m(engine.resource_cache().resource<shader_t>("blur.sha")),
+    upsample_shader_m(engine.resource_cache().resource<shader_t>("upsample.sha")),
     bloom_shader_m(engine.resource_cache().resource<shader_t>("bloom.sha")),
-    blur_render_target_m(
-        {render_target_t::create(engine_m.viewport_size(), 1), render_target_t::create(engine_m.viewport_size(), 1)}),
     result_render_target_m(render_target_t::create(engine_m.viewport_size(), 1))
 {
+    for(size_t level = 0; level < level_count_k; ++level)
+    {
+        const glm::ivec2 size = glm::max(engine_m.viewport_size() / (2 << static_cast<int>(level)), glm::ivec2{1});
+
+        // Levels are sampled at other resolutions than their own, so filter them to keep the bloom from getting blocky.
+        for(auto& render_target: level_render_targets_m[level])
+        {
+            render_target = render_target_t::create(size, 1);
+            render_target->texture(0)->set_filter(texture_filter_t::linear_k);
+        }
+    }
 }
 effect_bloom_t::~effect_bloom_t()
 {
 }
 render_target_handle_t effect_bloom_t::apply(render_target_handle_t pInput)
 {
-    depth_guard_t lock{renderer_m, depth_test_t::disabled_k};
+    MAU_PROFILE_ZONE("bloom");
+    gpu_pass_guard_t gpu_pass{renderer_m, "bloom"};
 
-    renderer_m.bind_render_target(blur_render_target_m[0]);
-    renderer_m.bind_shader(blur_shader_m);
-    renderer_m.bind_texture(pInput->texture(1), 0);
-    blur_shader_m->set_uniform_int(shader_uniform_t::pass_k, 0);
-    {
-        vertex_batch_t batch{renderer_m, vertex_primitive_t::triangle_k};
-        renderer_m.batch_framebuffer_fullscreen(batch, framebuffer_render_mode_t::fill_ndc_k);
-    }
-    renderer_m.bind_render_target(blur_render_target_m[1]);
-    renderer_m.bind_texture(blur_render_target_m[0]->texture(0), 0);
-    blur_shader_m->set_uniform_int(shader_uniform_t::pass_k, 1);
-    {
-        vertex_batch_t batch{renderer_m, vertex_primitive_t::triangle_k };
-        renderer_m.batch_framebuffer_fullscreen(batch, framebuffer_render_mode_t::fill_ndc_k);
-    }
+    depth_guard_t lock{renderer_m, depth_test_t::disabled_k};
 
-    static constexpr auto blur_count_k = 16;
+    // Every pass overwrites its whole target, so there's nothing to blend with.
+    const blend_mode_t blend_mode = renderer_m.blend_mode();
+    renderer_m.set_blend_mode(blend_mode_t::disabled_k);
 
-    for(int i = 0; i < blur_count_k; ++i)
+    // Downsample the bright parts of the scene level by level, blurring every level before going down to the next. A
+    // small blur on a coarse level spreads as far as a large one would at full resolution, for a fraction of the cost.
+    texture_handle_t source = pInput->texture(1);
+    for(auto& render_targets: level_render_targets_m)
     {
+        renderer_m.draw_fullscreen_pass({render_targets[0], downsample_shader_m, {source}});
+
         for(int pass = 0; pass < 2; ++pass)
         {
-            renderer_m.bind_render_target(blur_render_target_m[pass]);
-            renderer_m.bind_texture(blur_render_target_m[1 - pass]->texture(0), 0);
+            renderer_m.begin_render_pass({render_targets[1 - pass], blur_shader_m, {render_targets[pass]->texture(0)}});
             blur_shader_m->set_uniform_int(shader_uniform_t::pass_k, pass);
-            {
-                vertex_batch_t batch{renderer_m, vertex_primitive_t::triangle_k };
-                renderer_m.batch_framebuffer_fullscreen(batch, framebuffer_render_mode_t::fill_ndc_k);
-            }
+            renderer_m.render_fullscreen_triangle();
         }
+
+        source = render_targets[0]->texture(0);
     }
 
-    renderer_m.bind_render_target(result_render_target_m);
-    renderer_m.bind_shader(bloom_shader_m);
-    bloom_shader_m->set_uniform_int(shader_uniform_t::texture0_k, 0);
-    bloom_shader_m->set_uniform_int(shader_uniform_t::texture1_k, 1);
-    renderer_m.bind_texture(pInput->texture(0), 0);
-    renderer_m.bind_texture(blur_render_target_m[1]->texture(0), 1);
+    // Work back up, adding every level onto the next finer one, so the bloom has both a tight core and a wide halo.
+    for(size_t level = level_count_k - 1; level-- > 0;)
     {
-        vertex_batch_t batch{renderer_m, vertex_primitive_t::triangle_k };
-        renderer_m.batch_framebuffer_fullscreen(batch, framebuffer_render_mode_t::fill_ndc_k);
+        auto& render_targets = level_render_targets_m[level];
+
+        const texture_handle_t blurred = render_targets[0]->texture(0);
+
+        renderer_m.draw_fullscreen_pass({render_targets[1], upsample_shader_m, {blurred, source}});
+        source = render_targets[1]->texture(0);
     }
 
+    renderer_m.draw_fullscreen_pass({result_render_target_m, bloom_shader_m, {pInput->texture(0), source}});
+
+    renderer_m.set_blend_mode(blend_mode);
+
     return result_render_target_m;
 }
 
@@ -14,10 +14,12 @@ static constexpr float enemy_bounding_height_k = 0.75f;
 
 namespace mau {
 enemy_t::enemy_t(world_t& world, glm::vec3 position, const enemy_descriptor_t& descriptor) :
-    sprite_entity_t(world, {position.x, enemy_bounding_height_k / 2.0f, position.z}), descriptor_m(descriptor)
+    sprite_entity_t(world, {position.x, enemy_bounding_height_k / 2.0f, position.z}),
+    descriptor_m(descriptor),
+    random_m(world.next_random_seed())
 {
-    bounding_box_m = {0.25f, enemy_bounding_height_k, 0.25f};
-    sprite_scale_m = bounding_box_m.y;
+    set_bounding_box({0.25f, enemy_bounding_height_k, 0.25f});
+    sprite_scale_m = enemy_bounding_height_k;
     set_blocking(true);
 
     health_m        = descriptor_m.health;
@@ -39,38 +41,38 @@ void enemy_t::fixed_update(float delta_time)
         switch(state_m)
         {
             case enemy_state_t::unaware_k: {
-                if(state_timer_m >= unaware_interval_k)
+                if(awaiting_sight_m)
                 {
-                    state_timer_m = 0.0f;
-
-                    // Raycast and acquire player.
-                    entity_t* player{nullptr};
-                    world_m.raycast(position(), player_normal, collision_layers::player_k, nullptr, &player);
+                    // Look out for the player, as queried during the previous tick.
+                    awaiting_sight_m = false;
 
-                    if (player)
+                    if(world_m.line_of_sight_hit(sight_query_m))
                     {
-                        world_m.engine().audio().play_clip(descriptor_m.detect_sound, position());
+                        world_m.play_sound_at(descriptor_m.detect_sound, position());
                         state_m = enemy_state_t::acquiring_player_k;
                     }
                 }
+                else if(state_timer_m >= unaware_interval_k)
+                {
+                    state_timer_m = 0.0f;
+
+                    world_m.query_line_of_sight(
+                        position(), player_normal, collision_layers::player_k, nullptr, &sight_query_m);
+                    awaiting_sight_m = true;
+                }
                 else
                     state_timer_m += delta_time;
             }
             break;
             case enemy_state_t::acquiring_player_k: {
-                if(state_timer_m >= acquiring_player_interval_k)
+                if(awaiting_sight_m)
                 {
-                    state_timer_m = 0.0f;
-
-                    // Raycast for the player.
-                    entity_t* entity_hit{nullptr};
-                    world_m.raycast(
-                        position(), player_normal, collision_layers::player_k | collision_layers::enemy_k, this, &entity_hit);
-
-                    player_t* player = dynamic_cast<player_t*>(entity_hit);
+                    awaiting_sight_m = false;
 
                     // If nothing is obstructing the player and they are alive, fire.
-                    if(player && !player->dead())
+                    entity_t* entity_hit = world_m.line_of_sight_hit(sight_query_m);
+                    player_t* player     = world_m.player();
+                    if(entity_hit == player && !player->dead())
                     {
                         if(player_distance < fire_range_m)
                         {
@@ -85,15 +87,34 @@ void enemy_t::fixed_update(float delta_time)
                         }
                     }
                     else
-                    // If player obstructed or dead, move somewhere.
+                    // If player obstructed, find a way towards them. If there's none or they're dead, move somewhere.
                     {
-                        desired_direction_m   = glm::sphericalRand(1.0f);
-                        desired_direction_m.y = 0;
+                        const glm::vec3 path_direction = world_m.navigation_direction(position());
+
+                        if(!player->dead() && path_direction != glm::vec3{})
+                        {
+                            desired_direction_m = path_direction;
+                            following_path_m    = true;
+                        }
+                        else
+                            desired_direction_m = random_direction();
 
                         state_m = enemy_state_t::moving_k;
                         change_animation(enemy_descriptor_t::animation_t::walking_k);
                     }
                 }
+                else if(state_timer_m >= acquiring_player_interval_k)
+                {
+                    state_timer_m = 0.0f;
+
+                    // Look for the player, others of our kind may be in the way.
+                    world_m.query_line_of_sight(position(),
+                                                player_normal,
+                                                collision_layers::player_k | collision_layers::enemy_k,
+                                                this,
+                                                &sight_query_m);
+                    awaiting_sight_m = true;
+                }
                 else
                     state_timer_m += delta_time;
             }
@@ -101,14 +122,24 @@ void enemy_t::fixed_update(float delta_time)
             case enemy_state_t::moving_k: {
                 if(state_timer_m >= move_duration_k)
                 {
-                    state_timer_m = 0.0f;
-                    state_m       = enemy_state_t::acquiring_player_k;
-                    velocity_m    = {};
+                    state_timer_m    = 0.0f;
+                    state_m          = enemy_state_t::acquiring_player_k;
+                    following_path_m = false;
+                    set_velocity({});
                 }
                 else
                 {
                     state_timer_m += delta_time;
-                    velocity_m    = desired_direction_m;
+
+                    // Keep turning along the way, one tile at a time.
+                    if(following_path_m)
+                    {
+                        const glm::vec3 path_direction = world_m.navigation_direction(position());
+                        if(path_direction != glm::vec3{})
+                            desired_direction_m = path_direction;
+                    }
+
+                    set_velocity(desired_direction_m);
                     orientation_m = glm::quatLookAt(glm::normalize(desired_direction_m), {0, 1, 0});
                 }
             }
@@ -121,15 +152,12 @@ void enemy_t::fixed_update(float delta_time)
                     state_m       = enemy_state_t::acquiring_player_k;
                     change_animation(enemy_descriptor_t::animation_t::shooting_k);
 
-                    auto projectile =
-                        std::make_unique<projectile_t>(world_m,
-                                                       position() + glm::vec3{0.0f, 0.1f, 0.0f},
-                                                       orientation(),
-                                                       projectile_owner_t::monster_k,
-                                                       world_m.projectile_descriptors().at(descriptor_m.projectile_type));
-                    world_m.add_entity(std::move(projectile));
+                    world_m.spawn_projectile(position() + glm::vec3{0.0f, 0.1f, 0.0f},
+                                             orientation(),
+                                             projectile_owner_t::monster_k,
+                                             descriptor_m.projectile_type);
 
-                    world_m.engine().audio().play_clip(descriptor_m.attack_sound);
+                    world_m.play_sound(descriptor_m.attack_sound);
                 }
                 else
                     state_timer_m += delta_time;
@@ -196,24 +224,35 @@ void enemy_t::take_damage(float damage)
         die();
     }
     else
-        world_m.engine().audio().play_clip(descriptor_m.hurt_sound, position());
+        world_m.play_sound_at(descriptor_m.hurt_sound, position());
 }
 void enemy_t::change_animation(enemy_descriptor_t::animation_t animation)
 {
     animation_m     = animation;
     current_frame_m = 0.0f;
 }
+glm::vec3 enemy_t::random_direction()
+{
+    // Point on the unit sphere, flattened onto the ground.
+    std::uniform_real_distribution<float> distribution{-1.0f, 1.0f};
+
+    const float height = distribution(random_m);
+    const float angle  = distribution(random_m) * glm::pi<float>();
+    const float radius = std::sqrt(1.0f - height * height);
+
+    return {radius * std::cos(angle), 0.0f, radius * std::sin(angle)};
+}
 void enemy_t::die()
 {
     if(dead_m)
         return;
 
     dead_m = true;
-    velocity_m = {};
+    set_velocity({});
     set_collision_layer(0);
     set_collision_mask(0);
     change_animation(enemy_descriptor_t::animation_t::dying_k);
 
-    world_m.engine().audio().play_clip(descriptor_m.death_sound, position());
+    world_m.play_sound_at(descriptor_m.death_sound, position());
 }
 } // namespace mau
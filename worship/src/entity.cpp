@@ -8,19 +8,33 @@ namespace mau {
 
 entity_t::entity_t(world_t& world, glm::vec3 position) : world_m(world)
 {
+    physics_index_m = world_m.physics().create(this);
     set_position(position);
+
+    // Don't sweep in from the origin on the first frame.
+    world_m.physics().previous_positions[physics_index_m] = position;
 }
 entity_t::~entity_t()
 {
-    world_m.spatial_entity_remove(this);
+    // Destroyed entities have already been swept out of the spatial index by the world.
+    if(!destroyed_m)
+        world_m.spatial_entity_remove(this);
+
+    world_m.physics().destroy(physics_index_m);
 }
 void entity_t::move(glm::vec3 amount, float delta_time)
 {
     static constexpr int32_t relevant_sample_size_k = 2;
 
-    glm::ivec3 rounded_size = {bounding_box_m.x + relevant_sample_size_k,
-                               bounding_box_m.y + relevant_sample_size_k,
-                               bounding_box_m.z + relevant_sample_size_k};
+    physics_components_t& physics = world_m.physics();
+
+    const glm::vec3        bounding_box    = physics.bounding_boxes[physics_index_m];
+    const collision_mask_t collision_layer = physics.layer_masks[physics_index_m];
+    const collision_mask_t collision_mask  = physics.collision_masks[physics_index_m];
+
+    glm::ivec3 rounded_size = {bounding_box.x + relevant_sample_size_k,
+                               bounding_box.y + relevant_sample_size_k,
+                               bounding_box.z + relevant_sample_size_k};
 
     bool wall_collision{false};
 
@@ -37,16 +51,28 @@ void entity_t::move(glm::vec3 amount, float delta_time)
         tile_info_t* current_tile = world_m.tile(glm::vec2(rounded_position.x, rounded_position.z));
         if(current_tile)
         {
-            for(entity_t* entity: current_tile->entities)
+            // Collision handlers may move entities in or out of the tile, so go over a copy of its entities. Copies
+            // are stacked, as handlers may move entities in turn.
+            static thread_local std::vector<entity_t*> tile_entities;
+
+            const size_t first = tile_entities.size();
+            tile_entities.insert(tile_entities.end(), current_tile->entities.begin(), current_tile->entities.end());
+            const size_t last = tile_entities.size();
+
+            for(size_t j = first; j < last; ++j)
             {
+                entity_t* entity = tile_entities[j];
+
                 if(entity == this)
                     continue;
                 if(entity->destroyed())
                     continue;
 
-                if(math::aabb_intersect(position(), bounding_box_m, entity->position(), entity->bounding_box_m))
+                const physics_index_t other = entity->physics_index_m;
+
+                if(math::aabb_intersect(position(), bounding_box, physics.positions[other], physics.bounding_boxes[other]))
                 {
-                    if((entity->collision_layer_m & collision_mask_m) != 0)
+                    if((physics.layer_masks[other] & collision_mask) != 0)
                     {
                         on_collision(*entity);
 
@@ -56,17 +82,22 @@ void entity_t::move(glm::vec3 amount, float delta_time)
                         }
                     }
 
-                    if((collision_layer_m & entity->collision_mask_m) != 0)
+                    if((collision_layer & physics.collision_masks[other]) != 0)
                         entity->on_collision(*this);
 
                     if(collision)
+                    {
+                        tile_entities.resize(first);
                         goto resolve_collision;
+                    }
                 }
             }
+
+            tile_entities.resize(first);
         }
 
         // We're on a 2D plane, so restrict vertical movement.
-        if(position().y < bounding_box_m.y / 2 || position().y > 1.0f - bounding_box_m.y / 2)
+        if(position().y < bounding_box.y / 2 || position().y > 1.0f - bounding_box.y / 2)
         {
             collision      = true;
             wall_collision = true;
@@ -90,7 +121,7 @@ void entity_t::move(glm::vec3 amount, float delta_time)
                     static constexpr glm::vec3 tile_size{1, 1, 1};
 
                     if(math::aabb_intersect(
-                           position(), bounding_box_m, glm::vec3(current_tile_position) + tile_offset, tile_size))
+                           position(), bounding_box, glm::vec3(current_tile_position) + tile_offset, tile_size))
                     {
                         collision      = true;
                         wall_collision = true;
@@ -106,7 +137,7 @@ void entity_t::move(glm::vec3 amount, float delta_time)
             pos[i] -= amount[i] * delta_time;
             set_position(pos);
 
-            velocity_m[i] *= -bounciness_m;
+            physics.velocities[physics_index_m][i] *= -physics.bouncinesses[physics_index_m];
 
             if(wall_collision)
                 on_wall_collision();
@@ -115,17 +146,11 @@ void entity_t::move(glm::vec3 amount, float delta_time)
 }
 void entity_t::fixed_update(float delta_time)
 {
-    if(gravity_m)
-        apply_force(glm::vec3{0, -gravity_constant_k, 0}, delta_time);
-
-    move(velocity_m, delta_time);
-
-    velocity_m -= velocity_m * friction_m;
 }
 void entity_t::variable_update(float delta_time)
 {
 }
-void entity_t::render(renderer_t& renderer, shader_handle_t ubershader, float delta_time)
+void entity_t::render(renderer_t&, shader_handle_t, shader_features_t, float)
 {
 }
 void entity_t::on_collision(entity_t& entity)
@@ -140,7 +165,8 @@ void entity_t::destroy()
 }
 void entity_t::apply_force(glm::vec3 force, float delta_time)
 {
-    velocity_m += force * delta_time / mass_m;
+    physics_components_t& physics = world_m.physics();
+    physics.velocities[physics_index_m] += force * delta_time / physics.masses[physics_index_m];
 }
 void entity_t::rotate(float degrees, glm::vec3 axis)
 {
@@ -149,53 +175,90 @@ void entity_t::rotate(float degrees, glm::vec3 axis)
 }
 glm::vec3 entity_t::position() const
 {
-    return position_m;
+    return world_m.physics().positions[physics_index_m];
+}
+glm::vec3 entity_t::interpolated_position(float alpha) const
+{
+    const physics_components_t& physics = world_m.physics();
+    return glm::mix(physics.previous_positions[physics_index_m], physics.positions[physics_index_m], alpha);
 }
 glm::quat entity_t::orientation() const
 {
     return orientation_m;
 }
+glm::vec3 entity_t::velocity() const
+{
+    return world_m.physics().velocities[physics_index_m];
+}
 glm::vec3 entity_t::bounding_box() const
 {
-    return bounding_box_m;
+    return world_m.physics().bounding_boxes[physics_index_m];
+}
+float entity_t::bounciness() const
+{
+    return world_m.physics().bouncinesses[physics_index_m];
 }
 bool entity_t::blocking() const
 {
-    return blocking_m;
+    return world_m.physics().blocking[physics_index_m];
+}
+bool entity_t::simulated() const
+{
+    return world_m.physics().simulated[physics_index_m];
 }
 collision_mask_t entity_t::collision_layer() const
 {
-    return collision_layer_m;
+    return world_m.physics().layer_masks[physics_index_m];
 }
 collision_mask_t entity_t::collision_mask() const
 {
-    return collision_mask_m;
+    return world_m.physics().collision_masks[physics_index_m];
 }
 void entity_t::set_position(glm::vec3 position)
 {
     world_m.spatial_entity_remove(this);
-    position_m = position;
+    world_m.physics().positions[physics_index_m] = position;
     world_m.spatial_entity_insert(this);
 }
 void entity_t::set_orientation(glm::quat orientation)
 {
     orientation_m = orientation;
 }
+void entity_t::set_velocity(glm::vec3 velocity)
+{
+    world_m.physics().velocities[physics_index_m] = velocity;
+}
+void entity_t::set_bounding_box(glm::vec3 bounding_box)
+{
+    world_m.physics().bounding_boxes[physics_index_m] = bounding_box;
+}
 void entity_t::set_friction(float friction)
 {
-    friction_m = friction;
+    world_m.physics().frictions[physics_index_m] = friction;
+}
+void entity_t::set_bounciness(float bounciness)
+{
+    world_m.physics().bouncinesses[physics_index_m] = bounciness;
+}
+void entity_t::set_gravity(bool gravity)
+{
+    world_m.physics().gravities[physics_index_m] = gravity;
 }
 void entity_t::set_blocking(bool blocking)
 {
-    blocking_m = blocking;
+    world_m.physics().blocking[physics_index_m] = blocking;
+}
+void entity_t::set_simulated(bool simulated)
+{
+    world_m.physics().simulated[physics_index_m] = simulated;
 }
 void entity_t::set_collision_layer(collision_mask_t collision_layer)
 {
-    collision_layer_m = collision_layer;
+    world_m.physics().layer_masks[physics_index_m] = collision_layer;
 }
 void entity_t::set_collision_mask(collision_mask_t collision_mask)
 {
-    collision_mask_m = collision_mask;
+    world_m.physics().collision_masks[physics_index_m] = collision_mask;
 }
 glm::vec3 entity_t::direction() const
 {
@@ -215,4 +278,14 @@ bool entity_t::destroyed() const
     return destroyed_m;
 }
 
+uint32_t entity_t::visible_frame() const
+{
+    return visible_frame_m;
+}
+
+void entity_t::set_visible_frame(uint32_t frame)
+{
+    visible_frame_m = frame;
+}
+
 } // namespace mau
@@ -3,7 +3,6 @@
 #include "worship/gameplay/entities/enemy.hpp"
 #include "worship/gameplay/entities/player.hpp"
 #include "worship/gameplay/entities/projectile.hpp"
-#include "worship/gameplay/particle_entity.hpp"
 #include "worship/gameplay/world/world.hpp"
 
 #include "mau/base/engine_context.hpp"
@@ -202,12 +201,8 @@ std::map<weapon_type_t, weapon_descriptor_t> create_weapon_descriptors(engine_co
     grenade_launcher.fire_callback  = [](world_t& world) {
         player_t* player = world.player();
 
-        auto projectile = std::make_unique<projectile_t>(world,
-                                                         player->camera_position(),
-                                                         player->orientation(),
-                                                         projectile_owner_t::player_k,
-                                                         world.projectile_descriptors().at(projectile_type_t::grenade_k));
-        world.add_entity(std::move(projectile));
+        world.spawn_projectile(
+            player->camera_position(), player->orientation(), projectile_owner_t::player_k, projectile_type_t::grenade_k);
     };
     grenade_launcher.muzzle_flash_light            = glm::vec3{2.0, 1.5, 1.0};
     descriptors[weapon_type_t::grenade_launcher_k] = grenade_launcher;
@@ -244,12 +239,8 @@ std::map<weapon_type_t, weapon_descriptor_t> create_weapon_descriptors(engine_co
             projectile_position = projectile_position + glm::normalize(vector) * desired_length;
         }
 
-        auto projectile = std::make_unique<projectile_t>(world,
-                                                         projectile_position,
-                                                         player->orientation(),
-                                                         projectile_owner_t::player_k,
-                                                         world.projectile_descriptors().at(projectile_type_t::player_plasma_k));
-        world.add_entity(std::move(projectile));
+        world.spawn_projectile(
+            projectile_position, player->orientation(), projectile_owner_t::player_k, projectile_type_t::player_plasma_k);
     };
     plasma_rifle.muzzle_flash_light            = glm::vec3{0.5, 1.0, 2.0};
     descriptors[weapon_type_t::plasma_rifle_k] = plasma_rifle;
@@ -307,19 +298,15 @@ std::map<weapon_type_t, weapon_descriptor_t> create_weapon_descriptors(engine_co
             particle_type_t particle_type = hit_entity ? particle_type_t::blood_splash_k : particle_type_t::bullet_hit_k;
 
             if(position)
-            {
-                auto particle =
-                    std::make_unique<particle_entity_t>(world, *position, world.particle_descriptors().at(particle_type));
-                world.add_entity(std::move(particle));
-            }
+                world.spawn_particles(*position, particle_type);
 
             if(particle_type == particle_type_t::bullet_hit_k)
                 world.add_dynamic_light(dynamic_light_t{*position, {0.25f, 0.125f, 0.005f}, 3, true});
 
-            enemy_t* hit_enemy = dynamic_cast<enemy_t*>(hit_entity);
-            if(hit_enemy)
+            // The raycast only considers the enemy layer, so anything hit is an enemy.
+            if(hit_entity)
             {
-                hit_enemy->take_damage(10);
+                static_cast<enemy_t*>(hit_entity)->take_damage(10);
             }
         }
     };
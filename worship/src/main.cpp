@@ -16,7 +16,9 @@ int main(int argc, char** argv)
     {
         try
         {
-            mau::engine_context_t engine{"Worship", log};
+            const auto options = mau::engine_options_t::parse(argc, argv);
+
+            mau::engine_context_t engine{"Worship", log, options};
             engine.run<mau::state_preloading_t>();
             if(!engine.restart_requested())
                 break;
@@ -82,6 +82,7 @@ void menu_t::render(float delta_time)
     glm::vec2 title_position{engine_m.viewport_size().x / 2.0f - title_m.length() * font_m->character_size.x / 2.0f,
                              menu_position.y - font_m->character_size.y * 2};
 
+    renderer.bind_texture(font_m->texture(), 0);
     // Scope vertex batch.
     {
         vertex_batch_t batch{renderer, vertex_primitive_t::triangle_k};
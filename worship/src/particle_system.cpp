@@ -0,0 +1,188 @@
+#include "worship/gameplay/particle_system.hpp"
+
+#include <mau/math/simd.hpp>
+
+namespace mau {
+
+// Advances one axis of every particle in the batch: position by velocity, then velocity by gravity.
+static void integrate_axis(float* position, float* velocity, const float* gravity, size_t count, float delta_time)
+{
+    const math::float4_t delta_time4 = math::splat4(delta_time);
+
+    size_t i = 0;
+    for(; i + math::float4_width_k <= count; i += math::float4_width_k)
+    {
+        math::float4_t velocity4 = math::load4(velocity + i);
+
+        math::store4(position + i, math::load4(position + i) + velocity4 * delta_time4);
+        math::store4(velocity + i, velocity4 + math::load4(gravity + i) * delta_time4);
+    }
+
+    for(; i < count; ++i)
+    {
+        position[i] += velocity[i] * delta_time;
+        velocity[i] += gravity[i] * delta_time;
+    }
+}
+
+// Counts down the remaining life of every particle in the batch.
+static void integrate_life(float* life, size_t count, float delta_time)
+{
+    const math::float4_t delta_time4 = math::splat4(delta_time);
+
+    size_t i = 0;
+    for(; i + math::float4_width_k <= count; i += math::float4_width_k)
+        math::store4(life + i, math::load4(life + i) - delta_time4);
+
+    for(; i < count; ++i)
+        life[i] -= delta_time;
+}
+
+size_t particle_system_t::batch_t::count() const
+{
+    return life.size();
+}
+void particle_system_t::batch_t::remove(size_t index)
+{
+    const size_t last = count() - 1;
+
+    position_x[index] = position_x[last];
+    position_y[index] = position_y[last];
+    position_z[index] = position_z[last];
+    velocity_x[index] = velocity_x[last];
+    velocity_y[index] = velocity_y[last];
+    velocity_z[index] = velocity_z[last];
+    gravity_x[index]  = gravity_x[last];
+    gravity_y[index]  = gravity_y[last];
+    gravity_z[index]  = gravity_z[last];
+    life[index]       = life[last];
+    size[index]       = size[last];
+    color[index]      = color[last];
+
+    position_x.pop_back();
+    position_y.pop_back();
+    position_z.pop_back();
+    velocity_x.pop_back();
+    velocity_y.pop_back();
+    velocity_z.pop_back();
+    gravity_x.pop_back();
+    gravity_y.pop_back();
+    gravity_z.pop_back();
+    life.pop_back();
+    size.pop_back();
+    color.pop_back();
+}
+
+particle_system_t::particle_system_t() :
+    vertex_object_m(vertex_object_t::create(vertex_primitive_t::point_k, vertex_object_mode_t::stream_k, {}))
+{
+}
+void particle_system_t::emit(glm::vec3 position, const particle_descriptor_t& descriptor)
+{
+    batch_t& batch = this->batch(descriptor);
+
+    uint16_t count = glm::linearRand(descriptor.count.first, descriptor.count.second);
+
+    for(uint16_t i = 0; i < count; ++i)
+    {
+        glm::vec3 offset = glm::sphericalRand(descriptor.radius);
+
+        float     velocity_magnitude = glm::linearRand(descriptor.velocity.first, descriptor.velocity.second);
+        glm::vec3 velocity           = glm::normalize(offset) * velocity_magnitude;
+
+        batch.position_x.push_back(position.x + offset.x);
+        batch.position_y.push_back(position.y + offset.y);
+        batch.position_z.push_back(position.z + offset.z);
+        batch.velocity_x.push_back(velocity.x);
+        batch.velocity_y.push_back(velocity.y);
+        batch.velocity_z.push_back(velocity.z);
+        batch.gravity_x.push_back(descriptor.gravity.x);
+        batch.gravity_y.push_back(descriptor.gravity.y);
+        batch.gravity_z.push_back(descriptor.gravity.z);
+        batch.life.push_back(glm::linearRand(descriptor.lifetime.first, descriptor.lifetime.second));
+        batch.size.push_back(descriptor.particle_size);
+        batch.color.push_back(glm::linearRand(descriptor.color.first, descriptor.color.second));
+    }
+}
+void particle_system_t::update(float delta_time)
+{
+    for(auto& batch: batches_m)
+    {
+        const size_t count = batch.count();
+
+        integrate_axis(batch.position_x.data(), batch.velocity_x.data(), batch.gravity_x.data(), count, delta_time);
+        integrate_axis(batch.position_y.data(), batch.velocity_y.data(), batch.gravity_y.data(), count, delta_time);
+        integrate_axis(batch.position_z.data(), batch.velocity_z.data(), batch.gravity_z.data(), count, delta_time);
+        integrate_life(batch.life.data(), count, delta_time);
+
+        // Compact dead particles away, so neither updating nor rendering has to skip over them.
+        for(size_t i = 0; i < batch.count();)
+        {
+            if(batch.life[i] <= 0.0f)
+                batch.remove(i);
+            else
+                ++i;
+        }
+    }
+}
+void particle_system_t::render(renderer_t& renderer, shader_handle_t ubershader, shader_features_t features)
+{
+    if(size() == 0)
+        return;
+
+    // Stream all live particles into the shared vertex object. Per-particle size is carried in the UV attribute.
+    vertices_m.clear();
+    for(const auto& batch: batches_m)
+    {
+        for(size_t i = 0; i < batch.count(); ++i)
+        {
+            vertices_m.push_back(vertex_t{glm::vec3{batch.position_x[i], batch.position_y[i], batch.position_z[i]},
+                                          glm::vec2{batch.size[i], 0.0f},
+                                          batch.color[i]});
+        }
+    }
+    renderer.upload_vertices(vertex_object_m, vertices_m);
+
+    // Particles aren't lit.
+    shader_handle_t shader = ubershader->variant((features & ~shader_features::lighting_k) |
+                                                 shader_features::particle_mode_k);
+
+    renderer.bind_shader(shader);
+    shader->set_uniform_mat4(shader_uniform_t::model_matrix_k, glm::identity<glm::mat4>());
+    shader->set_uniform_float(shader_uniform_t::particle_size_k, 1.0f);
+
+    size_t first = 0;
+    for(const auto& batch: batches_m)
+    {
+        if(batch.count() == 0)
+            continue;
+
+        renderer.bind_texture(batch.texture_diffuse, 0);
+        renderer.bind_texture(batch.texture_emission, 1);
+        renderer.render_vertex_object(vertex_object_m, first, batch.count());
+
+        first += batch.count();
+    }
+}
+size_t particle_system_t::size() const
+{
+    size_t size = 0;
+    for(const auto& batch: batches_m)
+        size += batch.count();
+    return size;
+}
+particle_system_t::batch_t& particle_system_t::batch(const particle_descriptor_t& descriptor)
+{
+    for(auto& batch: batches_m)
+    {
+        if(batch.texture_diffuse == descriptor.texture_diffuse && batch.texture_emission == descriptor.texture_emission)
+            return batch;
+    }
+
+    batches_m.push_back({});
+    batches_m.back().texture_diffuse  = descriptor.texture_diffuse;
+    batches_m.back().texture_emission = descriptor.texture_emission;
+    return batches_m.back();
+}
+
+} // namespace mau
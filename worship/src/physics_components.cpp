@@ -0,0 +1,90 @@
+#include "worship/gameplay/physics_components.hpp"
+
+#include "worship/gameplay/entity.hpp"
+
+namespace mau {
+
+physics_index_t physics_components_t::create(entity_t* owner)
+{
+    const auto index = static_cast<physics_index_t>(owners.size());
+
+    owners.push_back(owner);
+    positions.push_back({0, 0, 0});
+    previous_positions.push_back({0, 0, 0});
+    velocities.push_back({0, 0, 0});
+    bounding_boxes.push_back({1, 1, 1});
+    masses.push_back(1.0f);
+    frictions.push_back(0.0f);
+    bouncinesses.push_back(0.0f);
+    gravities.push_back(false);
+    blocking.push_back(false);
+    simulated.push_back(true);
+    layer_masks.push_back(0);
+    collision_masks.push_back(0);
+
+    return index;
+}
+void physics_components_t::destroy(physics_index_t index)
+{
+    const physics_index_t last = static_cast<physics_index_t>(owners.size() - 1);
+
+    if(index != last)
+    {
+        owners[index]             = owners[last];
+        positions[index]          = positions[last];
+        previous_positions[index] = previous_positions[last];
+        velocities[index]         = velocities[last];
+        bounding_boxes[index]     = bounding_boxes[last];
+        masses[index]             = masses[last];
+        frictions[index]          = frictions[last];
+        bouncinesses[index]       = bouncinesses[last];
+        gravities[index]          = gravities[last];
+        blocking[index]           = blocking[last];
+        simulated[index]          = simulated[last];
+        layer_masks[index]        = layer_masks[last];
+        collision_masks[index]    = collision_masks[last];
+
+        owners[index]->physics_index_m = index;
+    }
+
+    owners.pop_back();
+    positions.pop_back();
+    previous_positions.pop_back();
+    velocities.pop_back();
+    bounding_boxes.pop_back();
+    masses.pop_back();
+    frictions.pop_back();
+    bouncinesses.pop_back();
+    gravities.pop_back();
+    blocking.pop_back();
+    simulated.pop_back();
+    layer_masks.pop_back();
+    collision_masks.pop_back();
+}
+size_t physics_components_t::size() const
+{
+    return owners.size();
+}
+void physics_components_t::integrate_gravity(float delta_time)
+{
+    const size_t count = size();
+    for(size_t i = 0; i < count; ++i)
+    {
+        // Multiplying by the flag instead of branching keeps this loop trivially vectorizable.
+        velocities[i].y -= gravities[i] * gravity_constant_k * delta_time / masses[i];
+    }
+}
+void physics_components_t::apply_friction()
+{
+    const size_t count = size();
+    for(size_t i = 0; i < count; ++i)
+    {
+        velocities[i] -= velocities[i] * frictions[i];
+    }
+}
+void physics_components_t::save_previous_positions()
+{
+    previous_positions = positions;
+}
+
+} // namespace mau
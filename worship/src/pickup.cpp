@@ -11,9 +11,12 @@ pickup_t::pickup_t(world_t& world, glm::vec3 position, pickup_descriptor_t descr
     texture_emission_m(descriptor.texture_emission),
     on_pickup(descriptor.callback)
 {
-    bounding_box_m = descriptor.bounding_box;
     sprite_scale_m = descriptor.sprite_scale;
 
+    // Pickups never move on their own; collisions with them are resolved from the player's side.
+    set_bounding_box(descriptor.bounding_box);
+    set_simulated(false);
+
     set_collision_layer(collision_layers::pickup_k);
     set_collision_mask(collision_layers::player_k);
 
@@ -41,7 +44,7 @@ texture_handle_t pickup_t::sprite_texture_emission()
 void pickup_t::on_collision(entity_t& entity)
 {
     // Collision layers ensure the player is the only entity we can collide with, so this is safe.
-    if(on_pickup(dynamic_cast<player_t&>(entity), world_m.event_callback()))
+    if(on_pickup(static_cast<player_t&>(entity), world_m.event_callback()))
     {
         destroyed_m = true;
 
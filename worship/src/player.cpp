@@ -11,12 +11,15 @@ static float max_health_k = 100.0f;
 static float max_armor_k  = 100.0f;
 
 player_t::player_t(world_t& world, glm::vec3 position, difficulty_t difficulty) :
-    entity_t(world, position), move_acceleration_m(50.0f), difficulty_m(difficulty)
+    entity_t(world, position),
+    move_acceleration_m(50.0f),
+    difficulty_m(difficulty),
+    random_m(world.next_random_seed())
 {
     set_friction(0.2f);
-    gravity_m      = false;
-    bounding_box_m = {0.5f, 0.99f, 0.5f};
-    blocking_m     = true;
+    set_gravity(false);
+    set_bounding_box({0.5f, 0.99f, 0.5f});
+    set_blocking(true);
 
     set_collision_mask(collision_layers::enemy_k);
     set_collision_layer(collision_layers::player_k);
@@ -39,9 +42,9 @@ void player_t::fixed_update(float delta_time)
         static constexpr float head_bob_speed_k   = 4.0f;
         static constexpr float weapon_bob_speed_k = 2.0f;
 
-        head_bob_m = std::remainder(head_bob_m + delta_time * head_bob_speed_k * glm::length(velocity_m), glm::two_pi<float>());
+        head_bob_m = std::remainder(head_bob_m + delta_time * head_bob_speed_k * glm::length(velocity()), glm::two_pi<float>());
         weapon_bob_m =
-            std::remainder(weapon_bob_m + delta_time * weapon_bob_speed_k * glm::length(velocity_m), glm::two_pi<float>());
+            std::remainder(weapon_bob_m + delta_time * weapon_bob_speed_k * glm::length(velocity()), glm::two_pi<float>());
 
         weapon_t* weapon = current_weapon();
         if(weapon)
@@ -122,6 +125,11 @@ glm::vec3 player_t::camera_position() const
     return position() + glm::vec3{0, 1, 0} * head_bob();
 }
 
+glm::vec3 player_t::interpolated_camera_position(float alpha) const
+{
+    return interpolated_position(alpha) + glm::vec3{0, 1, 0} * head_bob();
+}
+
 float player_t::move_acceleration() const
 {
     return move_acceleration_m;
@@ -306,7 +314,7 @@ void player_t::take_damage(float damage)
     }
     else
     {
-        world_m.engine().audio().play_clip(grunts_m[rand() % grunts_m.size()]);
+        world_m.play_sound(grunts_m[random_m() % grunts_m.size()]);
     }
 }
 
@@ -315,13 +323,13 @@ void player_t::die()
     if(dead_m)
         return;
 
-    velocity_m = {};
+    set_velocity({});
     dead_m     = true;
     world_m.event_callback().display_message(message_t::death_k);
     switching_weapons_m          = weapon_switch_t::lowering_k;
     switching_weapons_progress_m = 0.0f;
 
-    world_m.engine().audio().play_clip(death_sound_m);
+    world_m.play_sound(death_sound_m);
 }
 
 } // namespace mau
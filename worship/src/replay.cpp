@@ -0,0 +1,108 @@
+#include "worship/gameplay/replay.hpp"
+
+#include <fmt/format.h>
+
+#include <fstream>
+
+namespace mau {
+
+static constexpr uint32_t replay_magic_k   = 0x43455257; // "WREC"
+static constexpr uint32_t replay_version_k = 1;
+
+struct replay_header_t
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t seed;
+    uint32_t difficulty;
+    uint64_t command_count;
+};
+
+// Size of a command in the file, where it's stored field by field.
+static constexpr uint64_t command_size_k = 4 * sizeof(float) + 2 * sizeof(uint8_t);
+
+template<typename T>
+static void write_value(std::fstream& stream, const T& value)
+{
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+static void read_value(std::fstream& stream, T& value)
+{
+    stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+replay_t replay_t::load(const std::string& path)
+{
+    std::fstream stream{path, std::ios_base::in | std::ios_base::binary};
+    if(!stream)
+        throw exception_t{fmt::format("unable to open replay {}", path)};
+
+    replay_header_t header{};
+    read_value(stream, header);
+    if(!stream || header.magic != replay_magic_k)
+        throw exception_t{fmt::format("{} is not a replay", path)};
+    if(header.version != replay_version_k)
+        throw exception_t{fmt::format("replay {} has unsupported version {}", path, header.version)};
+    if(header.difficulty > static_cast<uint32_t>(difficulty_t::hard_k))
+        throw exception_t{fmt::format("replay {} has invalid difficulty {}", path, header.difficulty)};
+
+    // Check the count against what's left of the file, so a corrupt count can't make for a huge allocation.
+    const auto commands_start = stream.tellg();
+    stream.seekg(0, std::ios_base::end);
+    const auto commands_size = static_cast<uint64_t>(stream.tellg() - commands_start);
+    stream.seekg(commands_start);
+
+    if(header.command_count > commands_size / command_size_k)
+        throw exception_t{fmt::format("replay {} is truncated", path)};
+
+    replay_t replay;
+    replay.seed       = header.seed;
+    replay.difficulty = static_cast<difficulty_t>(header.difficulty);
+    replay.commands.resize(header.command_count);
+
+    // Commands are stored field by field, so padding doesn't end up in the file.
+    for(auto& command: replay.commands)
+    {
+        read_value(stream, command.orientation.x);
+        read_value(stream, command.orientation.y);
+        read_value(stream, command.orientation.z);
+        read_value(stream, command.orientation.w);
+        read_value(stream, command.buttons);
+        read_value(stream, command.weapon_slot);
+    }
+
+    if(!stream)
+        throw exception_t{fmt::format("replay {} is truncated", path)};
+
+    return replay;
+}
+void replay_t::save(const std::string& path) const
+{
+    std::fstream stream{path, std::ios_base::out | std::ios_base::binary};
+    if(!stream)
+        throw exception_t{fmt::format("unable to open replay {} for writing", path)};
+
+    write_value(stream,
+                replay_header_t{replay_magic_k,
+                                replay_version_k,
+                                seed,
+                                static_cast<uint32_t>(difficulty),
+                                static_cast<uint64_t>(commands.size())});
+
+    for(const auto& command: commands)
+    {
+        write_value(stream, command.orientation.x);
+        write_value(stream, command.orientation.y);
+        write_value(stream, command.orientation.z);
+        write_value(stream, command.orientation.w);
+        write_value(stream, command.buttons);
+        write_value(stream, command.weapon_slot);
+    }
+
+    if(!stream)
+        throw exception_t{fmt::format("error while writing replay {}", path)};
+}
+
+} // namespace mau
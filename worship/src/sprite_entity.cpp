@@ -9,15 +9,12 @@ sprite_entity_t::sprite_entity_t(world_t& world, glm::vec3 position) : entity_t(
 sprite_entity_t::~sprite_entity_t()
 {
 }
-void sprite_entity_t::render(renderer_t& renderer, shader_handle_t ubershader, float delta_time)
+void sprite_entity_t::render(renderer_t&       renderer,
+                             shader_handle_t   ubershader,
+                             shader_features_t features,
+                             float             delta_time)
 {
-    renderer.bind_texture(sprite_texture_diffuse(), 0);
-    renderer.bind_texture(sprite_texture_emission(), 1);
-
-    glm::mat4 model = glm::translate(position());
-
-    ubershader->set_uniform_mat4(shader_uniform_t::model_matrix_k, model);
-    ubershader->set_uniform_bool(shader_uniform_t::enable_sprite_billboarding_k, true);
+    const glm::vec3 position = interpolated_position(world_m.interpolation_alpha());
 
     glm::mat4 rotation = glm::rotate(sprite_rotation(), glm::vec3(0, 0, -1));
 
@@ -29,21 +26,26 @@ void sprite_entity_t::render(renderer_t& renderer, shader_handle_t ubershader, f
     static constexpr glm::vec2 tex_coords_k[] = {
         glm::vec2{0.0f, 0.0f}, glm::vec2{0.0f, 1.0f}, glm::vec2{1.0f, 0.0f}, glm::vec2{1.0f, 1.0f}};
 
-    const glm::vec4 lighting = world_m.light({position().x, position().z});
+    const glm::vec4 lighting = world_m.light({position.x, position.z});
+
+    const std::array<vertex_t, 6> vertices{vertex_t{vertices_k[0], tex_coords_k[0], lighting},
+                                           vertex_t{vertices_k[1], tex_coords_k[1], lighting},
+                                           vertex_t{vertices_k[2], tex_coords_k[2], lighting},
+                                           vertex_t{vertices_k[2], tex_coords_k[2], lighting},
+                                           vertex_t{vertices_k[1], tex_coords_k[1], lighting},
+                                           vertex_t{vertices_k[3], tex_coords_k[3], lighting}};
 
-    // Scope vertex batch.
-    {
-        vertex_batch_t batch{renderer, vertex_primitive_t::triangle_k};
-        batch.insert(vertex_t{vertices_k[0], tex_coords_k[0], lighting});
-        batch.insert(vertex_t{vertices_k[1], tex_coords_k[1], lighting});
-        batch.insert(vertex_t{vertices_k[2], tex_coords_k[2], lighting});
+    // Sprites are alpha tested, so their order doesn't matter for blending, and they're queued by texture.
+    draw_queue_t& draw_queue = renderer.draw_queue();
 
-        batch.insert(vertex_t{vertices_k[2], tex_coords_k[2], lighting});
-        batch.insert(vertex_t{vertices_k[1], tex_coords_k[1], lighting});
-        batch.insert(vertex_t{vertices_k[3], tex_coords_k[3], lighting});
-    }
+    draw_command_t command;
+    command.shader       = ubershader->variant(features | shader_features::sprite_billboarding_k);
+    command.textures     = {sprite_texture_diffuse(), sprite_texture_emission()};
+    command.first        = draw_queue.push_vertices(vertices);
+    command.count        = static_cast<uint32_t>(vertices.size());
+    command.model_matrix = glm::translate(position);
 
-    ubershader->set_uniform_bool(shader_uniform_t::enable_sprite_billboarding_k, false);
+    draw_queue.submit(draw_pass_t::alpha_tested_k, draw_queue.depth(position), std::move(command));
 }
 texture_handle_t sprite_entity_t::sprite_texture_diffuse()
 {
@@ -4,6 +4,7 @@
 #include "worship/gameplay/entities/projectile.hpp"
 #include "worship/states/state_main_menu.hpp"
 
+#include <mau/base/duration_statistics.hpp>
 #include <mau/base/engine_context.hpp>
 #include <mau/io/resource_cache.hpp>
 
@@ -12,13 +13,34 @@
 
 #include <GL/gl3w.h>
 
+#include <random>
+
 namespace mau {
 
-state_gameplay_t::state_gameplay_t(engine_context_t& engine, difficulty_t difficulty) :
+static std::string format_durations(const duration_statistics_t& statistics)
+{
+    return fmt::format("average {:.3f} ms, median {:.3f} ms, 99th percentile {:.3f} ms, maximum {:.3f} ms",
+                       statistics.average * 1000.0,
+                       statistics.median * 1000.0,
+                       statistics.percentile_99 * 1000.0,
+                       statistics.maximum * 1000.0);
+}
+static void set_lockstep_steps(frame_pacer_t& frame_pacer, uint32_t lockstep_steps)
+{
+    frame_pacer_settings_t settings = frame_pacer.settings();
+    settings.lockstep_steps         = lockstep_steps;
+    frame_pacer.set_settings(settings);
+}
+state_gameplay_t::state_gameplay_t(engine_context_t& engine, difficulty_t difficulty, std::optional<replay_t> replay) :
     state_t(engine, "gameplay"),
     event_callback_m(*this),
     effect_bloom_m(engine),
-    world_m(engine, event_callback_m, difficulty),
+    status_text_m(engine.renderer()),
+    message_text_m(engine.renderer()),
+    debug_text_m(engine.renderer()),
+    replay_m(replay ? std::move(*replay) : replay_t{std::random_device{}(), difficulty, {}}),
+    playing_back_m(replay.has_value()),
+    world_m(engine, event_callback_m, replay_m.difficulty, replay_m.seed),
     player_m(world_m.player()),
     ammo_icons_m(create_ammo_icons(engine))
 {
@@ -31,6 +53,43 @@ state_gameplay_t::state_gameplay_t(engine_context_t& engine, difficulty_t diffic
     gui_indicator_health_m     = engine.resource_cache().resource<texture_t>("pickups/health-diffuse-0000.tex");
     gui_indicator_armor_m      = engine.resource_cache().resource<texture_t>("pickups/armor-diffuse-0000.tex");
     gui_screen_flash_texture_m = engine.resource_cache().resource<texture_t>("white.tex");
+
+    // Loading the level took a while, which shouldn't be caught up on.
+    engine.frame_pacer().reset();
+
+    // Playback runs a tick every frame, so it goes as fast as frames do rather than at the recording's pace.
+    if(playing_back_m)
+        set_lockstep_steps(engine.frame_pacer(), 1);
+    frame_timer_m.reset();
+}
+std::string_view state_gameplay_t::status_number_t::format(int32_t new_value)
+{
+    if(value != new_value)
+    {
+        value = new_value;
+        text  = fmt::format("{}", new_value);
+    }
+
+    return text;
+}
+state_gameplay_t::~state_gameplay_t()
+{
+    if(playing_back_m)
+        set_lockstep_steps(engine_m.frame_pacer(), 0);
+
+    const std::string& record_path = engine_m.options().record_path;
+    if(playing_back_m || record_path.empty())
+        return;
+
+    try
+    {
+        replay_m.save(record_path);
+        engine_m.log().log(fmt::format("recorded {} ticks into {}", replay_m.commands.size(), record_path));
+    }
+    catch(exception_t& e)
+    {
+        engine_m.log().log(log_severity_t::error_k, e.what());
+    }
 }
 void state_gameplay_t::handle_event(const SDL_Event& event)
 {
@@ -39,9 +98,14 @@ void state_gameplay_t::handle_event(const SDL_Event& event)
         switch(event.key.keysym.scancode)
         {
             case SDL_SCANCODE_ESCAPE: engine_m.state_manager().push(std::make_unique<state_main_menu_t>(engine_m)); break;
-            case SDL_SCANCODE_1: player_m->select_weapon_slot(1); break;
-            case SDL_SCANCODE_2: player_m->select_weapon_slot(2); break;
-            case SDL_SCANCODE_3: player_m->select_weapon_slot(3); break;
+            case SDL_SCANCODE_1: selected_weapon_slot_m = 1; break;
+            case SDL_SCANCODE_2: selected_weapon_slot_m = 2; break;
+            case SDL_SCANCODE_3: selected_weapon_slot_m = 3; break;
+            case SDL_SCANCODE_F3:
+                show_profile_m = !show_profile_m;
+                shown_profile_m.clear();
+                engine_m.profiler().set_enabled(show_profile_m || !engine_m.options().profile_path.empty());
+                break;
             default: break;
         }
     }
@@ -51,48 +115,67 @@ void state_gameplay_t::handle_event(const SDL_Event& event)
 }
 void state_gameplay_t::fixed_update(float delta_time)
 {
-    glm::vec3 look_direction{};
-
-    if(engine_m.is_key_down(SDL_SCANCODE_W) || engine_m.is_key_down(SDL_SCANCODE_UP))
-        look_direction += player_m->direction();
-    if(engine_m.is_key_down(SDL_SCANCODE_S) || engine_m.is_key_down(SDL_SCANCODE_DOWN))
-        look_direction -= player_m->direction();
-    if(engine_m.is_key_down(SDL_SCANCODE_A))
-        look_direction -= player_m->right();
-    if(engine_m.is_key_down(SDL_SCANCODE_D))
-        look_direction += player_m->right();
+    if(timedemo_finished_m)
+        return;
 
-    look_direction.y = 0;
+    player_command_t command;
+    if(playing_back_m)
+    {
+        // The state can't leave the stack halfway through the frame's ticks, so that waits for the variable update.
+        if(replay_cursor_m == replay_m.commands.size())
+        {
+            timedemo_finished_m = true;
+            return;
+        }
 
-    if(glm::length(look_direction))
-        look_direction = glm::normalize(look_direction);
+        command = replay_m.commands[replay_cursor_m++];
+    }
+    else
+    {
+        command = sample_command();
+        if(!engine_m.options().record_path.empty())
+            replay_m.commands.push_back(command);
+    }
 
-    player_m->walk(look_direction, delta_time);
+    apply_command(command, delta_time);
 
+    timer_t tick_timer;
     world_m.fixed_update(delta_time);
+
+    if(playing_back_m)
+        tick_times_m.push_back(tick_timer.microseconds());
 }
 void state_gameplay_t::variable_update(float delta_time)
 {
     static constexpr float turn_dampening_mouse_k = 128.0f;
     static constexpr float turn_dampening_keyboard_k = 16.0f;
 
-    const glm::vec2 mouse_motion = engine_m.mouse_motion() * 0.01f;
+    if(timedemo_finished_m)
+    {
+        report_timedemo();
+        engine_m.state_manager().clear();
+        return;
+    }
 
-    player_m->rotate(-mouse_motion.x / turn_dampening_mouse_k, glm::vec3{0.0f, 1.0f, 0.0f});
+    if(playing_back_m)
+    {
+        frame_times_m.push_back(frame_timer_m.microseconds());
+        frame_timer_m.reset();
+    }
+    else
+    {
+        const glm::vec2 mouse_motion = engine_m.mouse_motion() * 0.01f;
 
-    float desired_rotation = 0.0f;
-    if(engine_m.is_key_down(SDL_SCANCODE_LEFT))
-        desired_rotation = 1.0f;
-    if(engine_m.is_key_down(SDL_SCANCODE_RIGHT))
-        desired_rotation = -1.0f;
+        player_m->rotate(-mouse_motion.x / turn_dampening_mouse_k, glm::vec3{0.0f, 1.0f, 0.0f});
 
-    if(desired_rotation)
-        player_m->rotate(desired_rotation * delta_time / turn_dampening_keyboard_k, glm::vec3{0.0f, 1.0f, 0.0f});
+        float desired_rotation = 0.0f;
+        if(engine_m.is_key_down(SDL_SCANCODE_LEFT))
+            desired_rotation = 1.0f;
+        if(engine_m.is_key_down(SDL_SCANCODE_RIGHT))
+            desired_rotation = -1.0f;
 
-    if((SDL_GetMouseState(NULL, NULL) & SDL_BUTTON(SDL_BUTTON_LEFT)) ||
-        engine_m.is_key_down(SDL_SCANCODE_LCTRL))
-    {
-        player_m->fire();
+        if(desired_rotation)
+            player_m->rotate(desired_rotation * delta_time / turn_dampening_keyboard_k, glm::vec3{0.0f, 1.0f, 0.0f});
     }
 
     world_m.variable_update(delta_time);
@@ -103,6 +186,7 @@ void state_gameplay_t::variable_update(float delta_time)
 render_target_handle_t state_gameplay_t::render(float delta_time)
 {
     renderer_t& renderer = engine_m.renderer();
+    renderer.begin_gpu_pass("scene");
 
     renderer.bind_render_target(scene_render_target_m);
     renderer.clear({0.0f, 0.0f, 0.0f, 1.0f});
@@ -111,17 +195,18 @@ render_target_handle_t state_gameplay_t::render(float delta_time)
     //*****************************************************
     // RENDER WORLD
     //*****************************************************
-    glm::mat4 view       = math::view_matrix(player_m->camera_position(), player_m->orientation());
-    glm::mat4 projection = math::perspective_matrix(player_m->fov(), engine_m.viewport_size(), 0.1f, 1024.0f);
+    const glm::vec3 camera_position = player_m->interpolated_camera_position(world_m.interpolation_alpha());
 
-    renderer.bind_shader(ubershader_m);
-    ubershader_m->set_uniform_bool(shader_uniform_t::enable_emission_k, true);
-    ubershader_m->set_uniform_bool(shader_uniform_t::enable_fog_k, false);
-    ubershader_m->set_uniform_float(shader_uniform_t::fog_density_k, 0.10f);
+    glm::mat4 view       = math::view_matrix(camera_position, player_m->orientation());
+    glm::mat4 projection = math::perspective_matrix(player_m->fov(), engine_m.viewport_size(), 0.1f, 1024.0f);
 
-    world_m.render(delta_time, ubershader_m, projection, view);
+    pass_constants_t world_constants;
+    world_constants.view        = view;
+    world_constants.projection  = projection;
+    world_constants.resolution  = engine_m.viewport_size();
+    world_constants.fog_density = 0.10f;
 
-    ubershader_m->set_uniform_bool(shader_uniform_t::enable_fog_k, false);
+    world_m.render(delta_time, ubershader_m, shader_features::emission_k, world_constants);
 
     renderer.set_fill_mode(fill_mode_t::fill_k);
 
@@ -130,10 +215,9 @@ render_target_handle_t state_gameplay_t::render(float delta_time)
     //*****************************************************
 
     depth_guard_t lock{renderer, depth_test_t::disabled_k};
-    ubershader_m->set_uniform_bool(shader_uniform_t::enable_emission_k, false);
+    renderer.bind_shader(ubershader_m);
     ubershader_m->set_uniform_mat4(shader_uniform_t::model_matrix_k, glm::identity<glm::mat4>());
-    ubershader_m->set_uniform_mat4(shader_uniform_t::view_matrix_k, glm::identity<glm::mat4>());
-    ubershader_m->set_uniform_mat4(shader_uniform_t::projection_matrix_k, math::ortho_matrix(engine_m.viewport_size()));
+    renderer.set_pass_constants({glm::identity<glm::mat4>(), math::ortho_matrix(engine_m.viewport_size())});
 
     //*****************************************************
     // RENDER WEAPON
@@ -147,7 +231,10 @@ render_target_handle_t state_gameplay_t::render(float delta_time)
 
         glm::vec2 knockback = glm::vec2{1, 1} * weapon_knockback_multiplier_k * weapon->knockback_factor();
 
-        ubershader_m->set_uniform_bool(shader_uniform_t::enable_emission_k, true);
+        const shader_handle_t weapon_shader = ubershader_m->variant(shader_features::emission_k);
+        renderer.bind_shader(weapon_shader);
+        weapon_shader->set_uniform_mat4(shader_uniform_t::model_matrix_k, glm::identity<glm::mat4>());
+
         renderer.bind_texture(weapon->texture_diffuse(), 0);
         renderer.bind_texture(weapon->texture_emission(), 1);
         {
@@ -157,7 +244,7 @@ render_target_handle_t state_gameplay_t::render(float delta_time)
             renderer.batch_sprite(
                 batch, glm::vec2{130, 110} + player_m->weapon_bob() + knockback, weapon->texture_diffuse()->size(), lighting);
         }
-        ubershader_m->set_uniform_bool(shader_uniform_t::enable_emission_k, false);
+        renderer.bind_shader(ubershader_m);
     }
 
     //*****************************************************
@@ -219,58 +306,44 @@ render_target_handle_t state_gameplay_t::render(float delta_time)
 
     // Status text.
     {
-        vertex_batch_t batch{renderer, vertex_primitive_t::triangle_k};
-
-        int32_t health = (int32_t)player_m->health();
-        int32_t armor  = (int32_t)player_m->armor();
-        int32_t ammo   = (int32_t)player_m->ammo();
-
-        fmt::memory_buffer health_buffer;
-        format_to(health_buffer, "{}", health);
+        std::string_view health_view = health_text_m.format((int32_t)player_m->health());
+        std::string_view armor_view  = armor_text_m.format((int32_t)player_m->armor());
 
-        fmt::memory_buffer armor_buffer;
-        format_to(armor_buffer, "{}", armor);
-
-        fmt::memory_buffer ammo_buffer;
-        format_to(ammo_buffer, "{}", ammo);
-
-        std::string_view health_view{health_buffer.data(), health_buffer.size()};
-        std::string_view armor_view{armor_buffer.data(), armor_buffer.size()};
-        std::string_view ammo_view{ammo_buffer.data(), ammo_buffer.size()};
+        status_text_m.begin(font_large_m);
 
         // Health
-        renderer.batch_string(
-            batch, font_large_m, indicator_position_health + indicator_text_offset, health_view, text_color_k);
+        status_text_m.add_run(indicator_position_health + indicator_text_offset, health_view, text_color_k);
         // Armor
-        renderer.batch_string(batch, font_large_m, indicator_position_armor + indicator_text_offset, armor_view, text_color_k);
+        status_text_m.add_run(indicator_position_armor + indicator_text_offset, armor_view, text_color_k);
 
         if(weapon != nullptr)
         {
+            std::string_view ammo_view = ammo_text_m.format((int32_t)player_m->ammo());
+
             // Ammo
-            renderer.batch_string(batch,
-                                  font_large_m,
-                                  indicator_position_ammo -
+            status_text_m.add_run(indicator_position_ammo -
                                       glm::vec2{indicator_padding_k + font_large_m->character_size.x * ammo_view.length(),
                                                 -indicator_text_offset.y},
                                   ammo_view,
                                   text_color_k);
         }
+
+        status_text_m.draw();
     }
 
     // Game message.
     if(game_message_timer_m.seconds() < game_message_duration_k)
     {
-        vertex_batch_t batch{renderer, vertex_primitive_t::triangle_k};
-
-        // Player position.
-        renderer.batch_string(batch, font_medium_m, {4, 4}, messages_k.at(game_message_m), text_color_k);
+        message_text_m.begin(font_medium_m);
+        message_text_m.add_run({4, 4}, messages_k.at(game_message_m), text_color_k);
+        message_text_m.draw();
     }
 
+    // Debug text and the profile overlay.
+    debug_text_m.begin(font_small_m);
+
 #ifdef SHOW_DEBUG_INFO
-    // Debug text.
     {
-        vertex_batch_t batch{renderer, vertex_primitive_t::triangle_k};
-
         fmt::memory_buffer player_position_buffer;
         format_to(player_position_buffer, "Player: {:.4f}, {:.4f}", player_m->position().x, player_m->position().z);
         std::string_view player_position_view{player_position_buffer.data(), player_position_buffer.size()};
@@ -282,18 +355,128 @@ render_target_handle_t state_gameplay_t::render(float delta_time)
         const float delta = font_small_m->character_size.y;
 
         // Player position.
-        renderer.batch_string(batch, font_small_m, {0, delta}, player_position_view, text_color_k);
+        debug_text_m.add_run({0, delta}, player_position_view, text_color_k);
 
         // Framerate.
-        renderer.batch_string(batch, font_small_m, {0, delta * 2}, fps_view, text_color_k);
+        debug_text_m.add_run({0, delta * 2}, fps_view, text_color_k);
     }
 #endif
 
+    if(show_profile_m)
+        add_profile_text(renderer);
+
+    debug_text_m.draw();
+
+    renderer.end_gpu_pass();
+
     if(engine_m.config().bloom)
         return effect_bloom_m.apply(scene_render_target_m);
     else
         return scene_render_target_m;
 }
+player_command_t state_gameplay_t::sample_command()
+{
+    player_command_t command;
+    command.orientation = player_m->orientation();
+
+    if(engine_m.is_key_down(SDL_SCANCODE_W) || engine_m.is_key_down(SDL_SCANCODE_UP))
+        command.buttons |= player_buttons::forward_k;
+    if(engine_m.is_key_down(SDL_SCANCODE_S) || engine_m.is_key_down(SDL_SCANCODE_DOWN))
+        command.buttons |= player_buttons::backward_k;
+    if(engine_m.is_key_down(SDL_SCANCODE_A))
+        command.buttons |= player_buttons::left_k;
+    if(engine_m.is_key_down(SDL_SCANCODE_D))
+        command.buttons |= player_buttons::right_k;
+    if((SDL_GetMouseState(NULL, NULL) & SDL_BUTTON(SDL_BUTTON_LEFT)) || engine_m.is_key_down(SDL_SCANCODE_LCTRL))
+        command.buttons |= player_buttons::fire_k;
+
+    command.weapon_slot    = selected_weapon_slot_m;
+    selected_weapon_slot_m = 0;
+
+    return command;
+}
+void state_gameplay_t::apply_command(const player_command_t& command, float delta_time)
+{
+    player_m->set_orientation(command.orientation);
+
+    glm::vec3 look_direction{};
+
+    if(command.buttons & player_buttons::forward_k)
+        look_direction += player_m->direction();
+    if(command.buttons & player_buttons::backward_k)
+        look_direction -= player_m->direction();
+    if(command.buttons & player_buttons::left_k)
+        look_direction -= player_m->right();
+    if(command.buttons & player_buttons::right_k)
+        look_direction += player_m->right();
+
+    look_direction.y = 0;
+
+    if(glm::length(look_direction))
+        look_direction = glm::normalize(look_direction);
+
+    player_m->walk(look_direction, delta_time);
+
+    if(command.weapon_slot)
+        player_m->select_weapon_slot(command.weapon_slot);
+
+    if(command.buttons & player_buttons::fire_k)
+        player_m->fire();
+}
+void state_gameplay_t::report_timedemo()
+{
+    const auto frames = duration_statistics(frame_times_m);
+    const auto ticks  = duration_statistics(tick_times_m);
+
+    log_t& log = engine_m.log();
+    log.log(fmt::format("timedemo: {} ticks in {} frames, {:.2f} s, {:.1f} fps",
+                        ticks.count,
+                        frames.count,
+                        frames.total,
+                        frames.total > 0.0 ? frames.count / frames.total : 0.0));
+    log.log(fmt::format("frame times: {}", format_durations(frames)));
+    log.log(fmt::format("tick times: {}", format_durations(ticks)));
+}
+void state_gameplay_t::add_profile_text(renderer_t& renderer)
+{
+    static constexpr uint64_t refresh_milliseconds_k = 250;
+
+    if(shown_profile_m.empty() || profile_refresh_timer_m.milliseconds() >= refresh_milliseconds_k)
+    {
+        shown_profile_m = engine_m.profiler().frame_summary();
+        profile_refresh_timer_m.reset();
+    }
+
+    glm::vec2 position{4.0f, font_small_m->character_size.y * 4.0f};
+    for(const auto& zone: shown_profile_m)
+    {
+        // Nested zones are indented under their parents.
+        const std::string line =
+            fmt::format("{:{}}{} {:.2f} ms x{}", "", zone.depth * 2, zone.name, zone.seconds * 1000.0, zone.calls);
+
+        debug_text_m.add_run(position, line, text_color_k);
+        position.y += font_small_m->character_size.y;
+    }
+
+    position.y += font_small_m->character_size.y;
+    for(const auto& pass: renderer.gpu_pass_times())
+    {
+        const std::string line = fmt::format("gpu {} {:.2f} ms", pass.name, pass.seconds * 1000.0);
+
+        debug_text_m.add_run(position, line, text_color_k);
+        position.y += font_small_m->character_size.y;
+    }
+
+    const render_counters_t& counters = renderer.frame_counters();
+    const std::string        line     = fmt::format("draws {} uploads {} ({} kB) textures {} shaders {}",
+                                             counters.draw_calls,
+                                             counters.buffer_uploads,
+                                             counters.uploaded_bytes / 1024,
+                                             counters.texture_binds,
+                                             counters.shader_switches);
+
+    debug_text_m.add_run(position, line, text_color_k);
+}
 void state_gameplay_t::display_message(message_t message)
 {
     game_message_m = message;
@@ -7,7 +7,8 @@
 
 namespace mau {
 
-state_loading_t::state_loading_t(engine_context_t& engine, difficulty_t difficulty) : state_t(engine, "loading_screen")
+state_loading_t::state_loading_t(engine_context_t& engine, difficulty_t difficulty, std::optional<replay_t> replay) :
+    state_t(engine, "loading_screen"), replay_m(std::move(replay))
 {
     scene_render_target_m = render_target_t::create(engine.viewport_size(), 2);
     ubershader_m          = engine.resource_cache().resource<shader_t>("ubershader.sha");
@@ -26,7 +27,7 @@ void state_loading_t::variable_update(float delta_time)
     ++delay_counter_m;
     if(delay_counter_m > 1ULL)
     {
-        engine_m.state_manager().push_clear(std::make_unique<state_gameplay_t>(engine_m, difficulty_m));
+        engine_m.state_manager().push_clear(std::make_unique<state_gameplay_t>(engine_m, difficulty_m, std::move(replay_m)));
     }
 }
 render_target_handle_t state_loading_t::render(float delta_time)
@@ -38,10 +39,8 @@ render_target_handle_t state_loading_t::render(float delta_time)
     renderer.bind_shader(ubershader_m);
 
     depth_guard_t lock{renderer, depth_test_t::disabled_k};
-    ubershader_m->set_uniform_bool(shader_uniform_t::enable_emission_k, false);
     ubershader_m->set_uniform_mat4(shader_uniform_t::model_matrix_k, glm::identity<glm::mat4>());
-    ubershader_m->set_uniform_mat4(shader_uniform_t::view_matrix_k, glm::identity<glm::mat4>());
-    ubershader_m->set_uniform_mat4(shader_uniform_t::projection_matrix_k, math::ortho_matrix(engine_m.viewport_size()));
+    renderer.set_pass_constants({glm::identity<glm::mat4>(), math::ortho_matrix(engine_m.viewport_size())});
 
     renderer.bind_texture(background_m, 0);
     renderer.bind_texture(nullptr, 1);
@@ -52,6 +51,7 @@ render_target_handle_t state_loading_t::render(float delta_time)
         renderer.batch_sprite(batch, {0.0f, 0.0f}, engine_m.viewport_size(), glm::vec4(1.0f, 1.0f, 1.0f, 0.5f));
     }
 
+    renderer.bind_texture(font_medium_m->texture(), 0);
     // Scope vertex batch. Loading text.
     {
         vertex_batch_t batch{renderer, vertex_primitive_t::triangle_k};
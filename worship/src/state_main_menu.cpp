@@ -119,10 +119,8 @@ render_target_handle_t state_main_menu_t::render(float delta_time)
     renderer.bind_shader(ubershader_m);
 
     depth_guard_t lock{renderer, depth_test_t::disabled_k};
-    ubershader_m->set_uniform_bool(shader_uniform_t::enable_emission_k, false);
     ubershader_m->set_uniform_mat4(shader_uniform_t::model_matrix_k, glm::identity<glm::mat4>());
-    ubershader_m->set_uniform_mat4(shader_uniform_t::view_matrix_k, glm::identity<glm::mat4>());
-    ubershader_m->set_uniform_mat4(shader_uniform_t::projection_matrix_k, math::ortho_matrix(engine_m.viewport_size()));
+    renderer.set_pass_constants({glm::identity<glm::mat4>(), math::ortho_matrix(engine_m.viewport_size())});
 
     renderer.bind_texture(nullptr, 0);
     // Scope vertex batch. Dark overlay.
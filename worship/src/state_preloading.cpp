@@ -1,5 +1,6 @@
 #include "worship/states/state_preloading.hpp"
 
+#include "worship/states/state_loading.hpp"
 #include "worship/states/state_title_screen.hpp"
 
 #include <mau/base/engine_context.hpp>
@@ -39,7 +40,22 @@ void state_preloading_t::variable_update(float delta_time)
 
     preloading_result_m = engine_m.resource_cache().preload_next(preloading_context_m);
 
-    if(preloading_result_m.finished)
+    if(!preloading_result_m.finished)
+        return;
+
+    const engine_options_t& options = engine_m.options();
+
+    // Nobody is around to get through the menus when running unattended, so head straight into the game.
+    if(!options.timedemo_path.empty())
+    {
+        replay_t           replay     = replay_t::load(options.timedemo_path);
+        const difficulty_t difficulty = replay.difficulty;
+
+        engine_m.state_manager().push_clear(std::make_unique<state_loading_t>(engine_m, difficulty, std::move(replay)));
+    }
+    else if(options.unattended())
+        engine_m.state_manager().push_clear(std::make_unique<state_loading_t>(engine_m, difficulty_t::normal_k));
+    else
         engine_m.state_manager().push_clear(std::make_unique<state_title_screen_t>(engine_m));
 }
 render_target_handle_t state_preloading_t::render(float delta_time)
@@ -51,10 +67,8 @@ render_target_handle_t state_preloading_t::render(float delta_time)
     renderer.bind_shader(ubershader_m);
 
     depth_guard_t lock{renderer, depth_test_t::disabled_k};
-    ubershader_m->set_uniform_bool(shader_uniform_t::enable_emission_k, false);
     ubershader_m->set_uniform_mat4(shader_uniform_t::model_matrix_k, glm::identity<glm::mat4>());
-    ubershader_m->set_uniform_mat4(shader_uniform_t::view_matrix_k, glm::identity<glm::mat4>());
-    ubershader_m->set_uniform_mat4(shader_uniform_t::projection_matrix_k, math::ortho_matrix(engine_m.viewport_size()));
+    renderer.set_pass_constants({glm::identity<glm::mat4>(), math::ortho_matrix(engine_m.viewport_size())});
 
     renderer.bind_texture(background_m, 0);
     renderer.bind_texture(white_m, 1);
@@ -65,6 +79,7 @@ render_target_handle_t state_preloading_t::render(float delta_time)
         renderer.batch_sprite(batch, {0.0f, 0.0f}, engine_m.viewport_size(), glm::vec4(1.0f, 1.0f, 1.0f, 0.5f));
     }
 
+    renderer.bind_texture(font_small_m->texture(), 0);
     // Scope vertex batch. Loading text.
     {
         vertex_batch_t batch{renderer, vertex_primitive_t::triangle_k};
@@ -46,10 +46,8 @@ render_target_handle_t state_title_screen_t::render(float delta_time)
     renderer.bind_shader(ubershader_m);
 
     depth_guard_t lock{renderer, depth_test_t::disabled_k};
-    ubershader_m->set_uniform_bool(shader_uniform_t::enable_emission_k, false);
     ubershader_m->set_uniform_mat4(shader_uniform_t::model_matrix_k, glm::identity<glm::mat4>());
-    ubershader_m->set_uniform_mat4(shader_uniform_t::view_matrix_k, glm::identity<glm::mat4>());
-    ubershader_m->set_uniform_mat4(shader_uniform_t::projection_matrix_k, math::ortho_matrix(engine_m.viewport_size()));
+    renderer.set_pass_constants({glm::identity<glm::mat4>(), math::ortho_matrix(engine_m.viewport_size())});
 
     renderer.bind_texture(background_m, 0);
 
@@ -59,6 +57,7 @@ render_target_handle_t state_title_screen_t::render(float delta_time)
         renderer.batch_sprite(batch, {0.0f, 0.0f}, engine_m.viewport_size(), glm::vec4(1, 1, 1, 1));
     }
 
+    renderer.bind_texture(font_small_m->texture(), 0);
     // Scope vertex batch. Info and copyright text.
     {
         vertex_batch_t batch{renderer, vertex_primitive_t::triangle_k};
@@ -72,6 +71,7 @@ render_target_handle_t state_title_screen_t::render(float delta_time)
     // Scope vertex batch. Press any key text.
     if(press_any_key_visible_m)
     {
+        renderer.bind_texture(font_medium_m->texture(), 0);
         vertex_batch_t batch{renderer, vertex_primitive_t::triangle_k};
 
         constexpr std::string_view text = "PRESS ANY KEY";
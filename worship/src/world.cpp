@@ -6,15 +6,21 @@
 #include <mau/base/engine_context.hpp>
 #include <mau/io/resource_cache.hpp>
 #include <mau/math/algorithms.hpp>
+#include <mau/math/grid_raycast.hpp>
+#include <mau/profiling/profiler.hpp>
 
 #include <fmt/format.h>
 
 #include <algorithm>
+#include <cstdlib>
 #include <functional>
 #include <set>
 
 namespace mau {
 
+// Entities updated by a single job. Updates are cheap, so it takes a bunch of them to be worth a job.
+static constexpr size_t entity_update_grain_k = 64;
+
 std::vector<vertex_t> create_wireframe_cube()
 {
     static std::array<vertex_t, 8> cube_vertices = {
@@ -37,7 +43,15 @@ std::vector<vertex_t> create_wireframe_cube()
     return mesh_vertices;
 }
 
-world_t::world_t(engine_context_t& engine, event_callback_t& event_callback, difficulty_t difficulty) :
+void entity_deleter_t::operator()(entity_t* entity) const
+{
+    if(release)
+        release(pool, entity);
+    else
+        delete entity;
+}
+
+world_t::world_t(engine_context_t& engine, event_callback_t& event_callback, difficulty_t difficulty, uint32_t seed) :
     engine_m(engine),
     event_callback_m(event_callback),
     world_info_m(engine, engine.resource_cache().load_file("level1.lvl")),
@@ -47,6 +61,10 @@ world_t::world_t(engine_context_t& engine, event_callback_t& event_callback, dif
     particle_descriptors_m(create_particle_descriptors(engine)),
     enemy_descriptors_m(create_enemy_descriptors(engine))
 {
+    // glm's random functions, used for particles and weapon spread, draw from std::rand.
+    random_m.seed(seed);
+    std::srand(seed);
+
     tileset_texture_diffuse_m  = engine.resource_cache().resource<texture_t>("tileset-diffuse.tex");
     tileset_texture_emission_m = engine.resource_cache().resource<texture_t>("tileset-emission.tex");
     wireframe_texture_m        = engine.resource_cache().resource<texture_t>("white.tex");
@@ -136,35 +154,103 @@ world_t::world_t(engine_context_t& engine, event_callback_t& event_callback, dif
         }
     }
 
-    // Generate level chunks.
-    for(int32_t z = 0; z < world_info_m.size().y; z += chunk_size_k)
+    // Precompute which chunks can see each other. Regions match chunks, so region coordinates are chunk coordinates.
+    opaque_tiles_m = bit_grid_t{world_info_m.size()};
+    for(int32_t z = 0; z < world_info_m.size().y; ++z)
     {
-        for(int32_t x = 0; x < world_info_m.size().x; x += chunk_size_k)
+        for(int32_t x = 0; x < world_info_m.size().x; ++x)
         {
-            chunks_m.insert({chunk_position({x, z}), chunk_t{*this, {x, z}}});
+            opaque_tiles_m.set({x, z}, is_tile_type_opaque(world_info_m.tile({x, z})->type));
         }
     }
+
+    visibility_m       = potentially_visible_set_t{opaque_tiles_m, chunk_size_k, engine_m.jobs()};
+    visibility_query_m = visibility_query_t{visibility_m};
+    navigation_m       = flow_field_t{opaque_tiles_m};
+
+    // Generate level chunks in region order, all into one vertex object.
+    const int32_t region_total = visibility_m.region_count().x * visibility_m.region_count().y;
+
+    std::vector<vertex_t> chunk_vertices;
+
+    chunks_m.reserve(region_total);
+    for(int32_t region = 0; region < region_total; ++region)
+    {
+        chunks_m.emplace_back(
+            *this, visibility_m.region_position(region) * static_cast<int32_t>(chunk_size_k), chunk_vertices);
+    }
+
+    chunk_geometry_m =
+        vertex_object_t::create(vertex_primitive_t::triangle_k, vertex_object_mode_t::static_k, chunk_vertices);
 }
 void world_t::fixed_update(float delta_time)
 {
-    for(auto& entity: entities_m)
+    MAU_PROFILE_ZONE("world_tick");
+
+    // Enemies look up their way in the field, so it costs the same no matter how many of them there are.
+    const glm::ivec2 player_tile = glm::floor(glm::vec2{player_m->position().x, player_m->position().z});
+    if(player_tile != navigation_m.target())
+        navigation_m.compute(player_tile);
+
+    physics_m.save_previous_positions();
+
+    // Changes to the world are held back until the end of the tick.
     {
-        entity->fixed_update(delta_time);
+        world_commands_scope_t commands_scope{&tick_commands_m};
+
+        // Everybody else reacts to the player, so it goes first and on its own.
+        player_m->fixed_update(delta_time);
+
+        // Entities only change their own state while updating, anything else they do is deferred.
+        parallel_for_deferred(entities_m.size(), entity_update_grain_k, [this, delta_time](size_t begin, size_t end) {
+            MAU_PROFILE_ZONE("entity_update");
+
+            for(size_t i = begin; i < end; ++i)
+            {
+                if(entities_m[i].get() != player_m)
+                    entities_m[i]->fixed_update(delta_time);
+            }
+        });
+
+        // Integrate physics over the component arrays.
+        physics_m.integrate_gravity(delta_time);
+
+        move_bodies(delta_time);
+
+        physics_m.apply_friction();
     }
 
-    // Clean up entities marked for garbage collection.
-    entities_m.erase(std::remove_if(entities_m.begin(),
-                                    entities_m.end(),
-                                    [](const std::unique_ptr<entity_t>& entity) { return entity->destroyed(); }),
-                     entities_m.end());
+    // Spawned entities join in from the next tick on.
+    apply_commands();
+
+    remove_destroyed_entities();
+
+    // Answer line of sight queries made during this tick. Done after the clean up, so results never point to freed
+    // entities while they're read during the next tick.
+    resolve_line_of_sight();
+}
+void world_t::move_bodies(float delta_time)
+{
+    MAU_PROFILE_ZONE("move_bodies");
+
+    // Movement has to go through the entity, since resolving collisions invokes its callbacks. Regions match chunks.
+    body_partitions_m.partition(physics_m, visibility_m);
+    body_partitions_m.move(
+        engine_m.jobs(), range_commands_m, tick_commands_m, [this, delta_time](physics_index_t index) {
+            physics_m.owners[index]->move(physics_m.velocities[index], delta_time);
+        });
 }
 void world_t::variable_update(float delta_time)
 {
+    interpolation_alpha_m = engine_m.frame_pacer().alpha();
+
     for(auto& entity: entities_m)
     {
         entity->variable_update(delta_time);
     }
 
+    particle_system_m.update(delta_time);
+
     // Fade existing lights.
     static constexpr float light_fade_speed_k = 4.0f;
     for(auto& light: dynamic_lights_m)
@@ -181,34 +267,56 @@ void world_t::variable_update(float delta_time)
     // Clean up lights which have faded out.
     dynamic_lights_m.erase(std::remove_if(dynamic_lights_m.begin(),
                                           dynamic_lights_m.end(),
-                                          [](const std::unique_ptr<dynamic_light_t>& light) {
-                                              return light->destroyed && glm::length(light->color) == 0;
+                                          [this](dynamic_light_t* light) {
+                                              if(!light->destroyed || glm::length(light->color) != 0)
+                                                  return false;
+
+                                              dynamic_light_pool_m.destroy(light);
+                                              return true;
                                           }),
                            dynamic_lights_m.end());
 }
-void world_t::render(float delta_time, shader_handle_t ubershader, const glm::mat4& projection, const glm::mat4& view)
+void world_t::render(float             delta_time,
+                     shader_handle_t   ubershader,
+                     shader_features_t features,
+                     pass_constants_t  constants)
 {
     auto& renderer = engine_m.renderer();
 
     //=========================================================================
-    // Occlusion query.
+    // Visibility.
     //=========================================================================
-    // Cast rays and keep track of chunks they touch. Then render these chunks only.
+    // Take the chunks potentially visible from the camera's chunk and keep those within the view. Then render these
+    // chunks and the entities inside of them only.
+
+    {
+        MAU_PROFILE_ZONE("visibility");
 
-    std::set<entity_t*>            visible_entities;
-    std::unordered_set<glm::ivec2> visible_chunks;
+        // Widen the view a little, so sprites straddling its edges don't pop.
+        static constexpr float view_margin_radians_k = 0.1f;
+        static constexpr float entity_margin_k       = 0.5f;
 
-    const float fov_step = player_m->fov() / (engine_m.viewport_size().x / 2.0f);
+        const glm::vec3 camera_position = player_m->interpolated_camera_position(interpolation_alpha());
+        const glm::vec2 view_origin{camera_position.x, camera_position.z};
+        const glm::vec2 view_direction  = glm::normalize(glm::vec2{player_m->direction().x, player_m->direction().z});
+        const float     view_half_angle = player_m->fov() / 2.0f + view_margin_radians_k;
 
-    for(float i = 0; i < engine_m.viewport_size().x / 2.0f; i += 1.0f)
-    {
-        float angle = fov_step * i;
+        visibility_query_m.begin_frame(view_origin, view_direction, view_half_angle);
 
-        auto direction_right = glm::rotate(player_m->direction(), angle, {0, 1, 0});
-        auto direction_left  = glm::rotate(player_m->direction(), -angle, {0, 1, 0});
+        visible_entities_m.clear();
+        for(auto& entity: entities_m)
+        {
+            const glm::vec3 position = entity->position();
+            const glm::vec2 extent =
+                glm::vec2{entity->bounding_box().x, entity->bounding_box().z} / 2.0f + entity_margin_k;
+            const glm::vec2 center{position.x, position.z};
 
-        raycast_walls(player_m->camera_position(), direction_right, &visible_chunks, &visible_entities);
-        raycast_walls(player_m->camera_position(), direction_left, &visible_chunks, &visible_entities);
+            if(!visibility_query_m.box_visible(center - extent, center + extent))
+                continue;
+
+            entity->set_visible_frame(visibility_query_m.frame());
+            visible_entities_m.push_back(entity.get());
+        }
     }
 
     //=========================================================================
@@ -217,77 +325,109 @@ void world_t::render(float delta_time, shader_handle_t ubershader, const glm::ma
 
     if(engine_m.config().dynamic_lighting)
     {
-        ubershader->set_uniform_bool(shader_uniform_t::enable_lighting_k, true);
+        MAU_PROFILE_ZONE("lighting");
 
-        // Fetch the most relevant lights.
-        auto lights = relevant_lights(player_m->position());
+        features |= shader_features::lighting_k;
 
-        // Prepare light data for the shader.
-        std::vector<glm::vec3> light_positions;
-        std::vector<glm::vec3> light_colors;
-        std::vector<float>     light_radii;
+        // Fetch the most relevant lights, which go along with the pass constants.
+        auto lights = relevant_lights(player_m->position());
 
-        for(auto& light: lights)
+        constants.light_count = static_cast<int32_t>(lights.size());
+        for(size_t i = 0; i < lights.size(); ++i)
         {
-            light_positions.push_back(light->position);
-            light_colors.push_back(light->color);
-            light_radii.push_back(light->radius);
+            constants.light_positions[i] = glm::vec4{lights[i]->position, lights[i]->radius};
+            constants.light_colors[i]    = glm::vec4{lights[i]->color, 0.0f};
         }
-
-        // TODO: There must be a better way to do this, we're grinding really hard against the uniform limit here.
-        ubershader->set_uniform_vec3_array(shader_uniform_t::light_positions_k, light_positions);
-        ubershader->set_uniform_vec3_array(shader_uniform_t::light_colors_k, light_colors);
-        ubershader->set_uniform_float_array(shader_uniform_t::light_radii_k, light_radii);
-        ubershader->set_uniform_int(shader_uniform_t::light_count_k, (int32_t)lights.size());
     }
 
+    renderer.set_pass_constants(constants);
+
+    const shader_handle_t shader = ubershader->variant(features);
+
     //=========================================================================
-    // Chunk rendering.
+    // Chunk and entity rendering.
     //=========================================================================
+    // Draws go through the renderer's queue, which sorts them. Chunks go first, front to back, so walls hide what's
+    // behind them before it's shaded, and sprites are grouped by texture.
 
-    ubershader->set_uniform_mat4(shader_uniform_t::model_matrix_k, glm::identity<glm::mat4>());
-    ubershader->set_uniform_mat4(shader_uniform_t::view_matrix_k, view);
-    ubershader->set_uniform_mat4(shader_uniform_t::projection_matrix_k, projection);
-
-    renderer.bind_texture(tileset_texture_diffuse_m, 0);
-    renderer.bind_texture(tileset_texture_emission_m, 1);
+    draw_queue_t& draw_queue = renderer.draw_queue();
+    draw_queue.set_camera_position(player_m->interpolated_camera_position(interpolation_alpha()));
 
-    for(auto chunk_coordinates: visible_chunks)
     {
-        auto it = chunks_m.find(chunk_coordinates);
-        if(it == chunks_m.end())
-            continue;
+        MAU_PROFILE_ZONE("chunk_render");
 
-        const auto& chunk = it->second;
-        engine_m.renderer().render_vertex_object(chunk.vertex_object());
-    }
+        // Visible chunks are ranges of one vertex object, drawn with a single multi-draw call.
+        visible_chunks_m.clear();
+        for(auto region: visibility_query_m.visible_regions())
+        {
+            const chunk_t& chunk = chunks_m[region];
+            if(chunk.count() == 0)
+                continue;
 
-    //=========================================================================
-    // Entity rendering.
-    //=========================================================================
+            const float depth = draw_queue.depth(chunk.center());
+            visible_chunks_m.push_back({draw_queue_t::depth_bits(depth), static_cast<uint32_t>(region)});
+        }
 
-    ubershader->set_uniform_mat4(shader_uniform_t::view_matrix_k, view);
-    ubershader->set_uniform_mat4(shader_uniform_t::projection_matrix_k, projection);
+        radix_sort(visible_chunks_m, visible_chunks_scratch_m);
 
-    for(auto& entity: visible_entities)
-    {
-        // Render wireframe box.
-        if(false)
+        chunk_firsts_m.clear();
+        chunk_counts_m.clear();
+        for(const auto& entry: visible_chunks_m)
         {
-            glm::mat4 model = glm::translate(entity->position()) * glm::scale(entity->bounding_box());
-
-            renderer.bind_texture(wireframe_texture_m, 0);
-            renderer.bind_texture(wireframe_texture_m, 1);
-            ubershader->set_uniform_mat4(shader_uniform_t::model_matrix_k, model);
+            chunk_firsts_m.push_back(chunks_m[entry.index].first());
+            chunk_counts_m.push_back(chunks_m[entry.index].count());
+        }
 
-            if(entity != player_m)
-                renderer.render_vertex_object(wireframe_cube_m);
+        if(!visible_chunks_m.empty())
+        {
+            draw_command_t command;
+            command.shader        = shader;
+            command.textures      = {tileset_texture_diffuse_m, tileset_texture_emission_m};
+            command.vertex_object = chunk_geometry_m;
+            command.first         = draw_queue.push_ranges(chunk_firsts_m, chunk_counts_m);
+            command.count         = static_cast<uint32_t>(chunk_firsts_m.size());
+            command.multi_draw    = true;
+
+            draw_queue.submit(draw_pass_t::opaque_k, 0.0f, std::move(command));
         }
+    }
 
-        entity->render(renderer, ubershader, delta_time);
+    {
+        MAU_PROFILE_ZONE("entity_render");
+
+        for(auto entity: visible_entities_m)
+        {
+            // Render wireframe box.
+            if(false)
+            {
+                draw_command_t command;
+                command.shader        = shader;
+                command.textures      = {wireframe_texture_m, wireframe_texture_m};
+                command.vertex_object = wireframe_cube_m;
+                command.count         = static_cast<uint32_t>(wireframe_cube_m->vertex_count());
+                command.model_matrix  = glm::translate(entity->position()) * glm::scale(entity->bounding_box());
+
+                if(entity != player_m)
+                {
+                    draw_queue.submit(
+                        draw_pass_t::opaque_k, draw_queue.depth(entity->position()), std::move(command));
+                }
+            }
+
+            entity->render(renderer, ubershader, features, delta_time);
+        }
     }
 
-    ubershader->set_uniform_bool(shader_uniform_t::enable_lighting_k, false);
+    draw_queue.execute();
+
+    //=========================================================================
+    // Particle rendering.
+    //=========================================================================
+
+    {
+        MAU_PROFILE_ZONE("particle_render");
+        particle_system_m.render(renderer, ubershader, features);
+    }
 }
 engine_context_t & world_t::engine()
 {
@@ -297,6 +437,14 @@ event_callback_t& world_t::event_callback()
 {
     return event_callback_m;
 }
+physics_components_t& world_t::physics()
+{
+    return physics_m;
+}
+float world_t::interpolation_alpha() const
+{
+    return interpolation_alpha_m;
+}
 tile_info_t* world_t::tile(glm::ivec2 tile_position)
 {
     return world_info_m.tile(tile_position);
@@ -304,13 +452,67 @@ tile_info_t* world_t::tile(glm::ivec2 tile_position)
 
 void world_t::add_entity(std::unique_ptr<entity_t> entity)
 {
-    entities_m.push_back(std::move(entity));
+    if(world_commands_t* commands = recording_world_commands())
+    {
+        commands->entities.push_back(std::move(entity));
+        return;
+    }
+
+    entities_m.push_back(entity_handle_t{entity.release()});
 }
 
 dynamic_light_t* world_t::add_dynamic_light(dynamic_light_t light)
 {
-    dynamic_lights_m.push_back(std::make_unique<dynamic_light_t>(light));
-    return dynamic_lights_m.back().get();
+    if(world_commands_t* commands = recording_world_commands())
+    {
+        commands->lights.push_back(light);
+        return nullptr;
+    }
+
+    dynamic_lights_m.push_back(dynamic_light_pool_m.create(light));
+    return dynamic_lights_m.back();
+}
+
+projectile_t* world_t::spawn_projectile(glm::vec3          position,
+                                        glm::quat          orientation,
+                                        projectile_owner_t owner,
+                                        projectile_type_t  type)
+{
+    if(world_commands_t* commands = recording_world_commands())
+    {
+        commands->projectiles.push_back({position, orientation, owner, type});
+        return nullptr;
+    }
+
+    return spawn_pooled(projectile_pool_m, *this, position, orientation, owner, projectile_descriptors_m.at(type));
+}
+
+void world_t::spawn_particles(glm::vec3 position, particle_type_t type)
+{
+    if(world_commands_t* commands = recording_world_commands())
+    {
+        commands->particles.push_back({position, type});
+        return;
+    }
+
+    particle_system_m.emit(position, particle_descriptors_m.at(type));
+}
+
+template<typename T, size_t BlockSize, typename... Args>
+T* world_t::spawn_pooled(object_pool_t<T, BlockSize>& pool, Args&&... args)
+{
+    using pool_t = object_pool_t<T, BlockSize>;
+
+    T* entity = pool.create(std::forward<Args>(args)...);
+
+    entity_deleter_t deleter;
+    deleter.pool    = &pool;
+    deleter.release = [](void* pool, entity_t* entity) {
+        static_cast<pool_t*>(pool)->destroy(static_cast<T*>(entity));
+    };
+
+    entities_m.push_back(entity_handle_t{entity, deleter});
+    return entity;
 }
 
 void world_t::spatial_entity_insert(entity_t* entity)
@@ -339,13 +541,12 @@ std::vector<dynamic_light_t*> world_t::relevant_lights(glm::vec3 position) const
 
     for(auto& light: dynamic_lights_m)
     {
-        sorted_lights.insert(light.get());
+        sorted_lights.insert(light);
     }
 
-    static constexpr size_t max_light_count_k = 32;
     for(auto& light: sorted_lights)
     {
-        if(relevant_lights.size() < max_light_count_k)
+        if(relevant_lights.size() < pass_constants_max_lights_k)
             relevant_lights.push_back(light);
     }
 
@@ -388,20 +589,84 @@ glm::vec4 world_t::light(glm::vec2 position)
 std::optional<glm::vec3> world_t::raycast(glm::vec3 position, glm::vec3 direction, uint64_t collision_mask, entity_t* ignore_entity, entity_t** hit_entity)
 {
     // Raycast both wall and entities. Return whichever point the ray hits closer.
-    std::set<entity_t*> entities;
+    raycast_entities_m.clear();
+    auto hit_wall = raycast_walls(position, direction, &raycast_entities_m);
+
+    return nearest_raycast_hit(position, direction, hit_wall, collision_mask, ignore_entity, hit_entity);
+}
+
+void world_t::query_line_of_sight(glm::vec3              position,
+                                  glm::vec3              direction,
+                                  collision_mask_t       collision_mask,
+                                  entity_t*              ignore_entity,
+                                  line_of_sight_query_t* query)
+{
+    if(world_commands_t* commands = recording_world_commands())
+    {
+        commands->line_of_sight_queries.push_back({position, direction, collision_mask, ignore_entity, query});
+        return;
+    }
+
+    direction.y = 0;
+    direction   = glm::normalize(direction);
+
+    line_of_sight_requests_m.push_back({position, direction, collision_mask, ignore_entity});
+
+    *query = static_cast<line_of_sight_query_t>(line_of_sight_requests_m.size() - 1);
+}
+
+entity_t* world_t::line_of_sight_hit(line_of_sight_query_t query) const
+{
+    return line_of_sight_hits_m.at(query);
+}
+
+void world_t::resolve_line_of_sight()
+{
+    MAU_PROFILE_ZONE("line_of_sight");
+
+    // Sight lines are short, which the scalar DDA handles faster than packets of rays would.
+    line_of_sight_hits_m.assign(line_of_sight_requests_m.size(), nullptr);
+
+    for(size_t i = 0; i < line_of_sight_requests_m.size(); ++i)
+    {
+        const auto& request = line_of_sight_requests_m[i];
+
+        raycast_entities_m.clear();
+        const auto hit_wall = raycast_walls(request.position, request.direction, &raycast_entities_m);
+
+        nearest_raycast_hit(request.position,
+                            request.direction,
+                            hit_wall,
+                            request.collision_mask,
+                            request.ignore_entity,
+                            &line_of_sight_hits_m[i]);
+    }
+
+    line_of_sight_requests_m.clear();
+}
 
+std::optional<glm::vec3> world_t::nearest_raycast_hit(glm::vec3                position,
+                                                      glm::vec3                direction,
+                                                      std::optional<glm::vec3> hit_wall,
+                                                      collision_mask_t         collision_mask,
+                                                      entity_t*                ignore_entity,
+                                                      entity_t**               hit_entity)
+{
     if(hit_entity)
         *hit_entity = nullptr;
 
     entity_t* entity = nullptr;
 
-    auto hit_wall     = raycast_walls(position, direction, nullptr, &entities);
+    // Entities spanning several tiles got collected more than once. Drop these along with the ignored entity.
+    std::sort(raycast_entities_m.begin(), raycast_entities_m.end());
+    raycast_entities_m.erase(std::unique(raycast_entities_m.begin(), raycast_entities_m.end()),
+                             raycast_entities_m.end());
 
-    // Remove ignored entity from set.
     if(ignore_entity)
-        entities.erase(ignore_entity);
+        raycast_entities_m.erase(std::remove(raycast_entities_m.begin(), raycast_entities_m.end(), ignore_entity),
+                                 raycast_entities_m.end());
 
-    auto hit_entities = raycast_entities(entities, position, direction, collision_mask, &entity);
+    auto hit_entities = raycast_entities(raycast_entities_m, position, direction, collision_mask, &entity);
 
     if(!hit_wall)
         return std::optional<glm::vec3>{};
@@ -421,88 +686,34 @@ std::optional<glm::vec3> world_t::raycast(glm::vec3 position, glm::vec3 directio
     }
 }
 
-std::optional<glm::vec3> world_t::raycast_walls(glm::vec3                       position,
-                                                glm::vec3                       direction,
-                                                std::unordered_set<glm::ivec2>* visited_chunks,
-                                                std::set<entity_t*>*            visited_entities)
+std::optional<glm::vec3> world_t::raycast_walls(glm::vec3               position,
+                                                glm::vec3               direction,
+                                                std::vector<entity_t*>* visited_entities)
 {
     direction.y = 0;
     direction   = glm::normalize(direction);
 
-    glm::ivec2 tile_position{position.x, position.z};
-
-    const glm::vec2 delta_distance{std::abs(1 / direction.x), std::abs(1 / direction.z)};
-
-    bool wall_hit{false};
-
-    tile_info_t* starting_tile = tile(tile_position);
-
-    if(visited_chunks)
-        visited_chunks->insert(chunk_position(tile_position));
-
-    if(visited_entities)
-        visited_entities->insert(starting_tile->entities.begin(), starting_tile->entities.end());
-
-    while(!wall_hit)
-    {
-        glm::vec2  side_distance{};
-        glm::ivec2 step_direction{};
-
-        if(direction.x < 0)
-        {
-            side_distance.x  = (position.x - tile_position.x) * delta_distance.x;
-            step_direction.x = -1;
-        }
-        else
-        {
-            side_distance.x  = (tile_position.x + 1.0f - position.x) * delta_distance.x;
-            step_direction.x = 1;
-        }
-
-        if(direction.z < 0)
-        {
-            side_distance.y  = (position.z - tile_position.y) * delta_distance.y;
-            step_direction.y = -1;
-        }
-        else
-        {
-            side_distance.y  = (tile_position.y + 1.0f - position.z) * delta_distance.y;
-            step_direction.y = 1;
-        }
-
-        if(side_distance.x < side_distance.y)
-        {
-            position += direction * side_distance.x;
-            tile_position.x += step_direction.x;
-        }
-        else
-        {
-            position += direction * side_distance.y;
-            tile_position.y += step_direction.y;
-        }
+    // Walls are looked up in the compact opaque bitmap. Tiles are only touched when entities are to be collected.
+    const auto collect_entities = [this, visited_entities](glm::ivec2 tile_position) {
+        if(!visited_entities)
+            return true;
 
-        tile_info_t* current_tile = tile(tile_position);
-        if(!current_tile)
+        if(auto current_tile = tile(tile_position))
         {
-            wall_hit = true;
-            break;
+            const auto& entities = current_tile->entities;
+            visited_entities->insert(visited_entities->end(), entities.begin(), entities.end());
         }
+        return true;
+    };
 
-        if(is_tile_type_opaque(current_tile->type))
-            wall_hit = true;
-
-        if(visited_chunks != nullptr)
-            visited_chunks->insert(chunk_position(tile_position));
-
-        if(visited_entities)
-            visited_entities->insert(current_tile->entities.begin(), current_tile->entities.end());
-    }
+    const glm::vec2 hit = math::grid_raycast(
+        opaque_tiles_m, glm::vec2{position.x, position.z}, glm::vec2{direction.x, direction.z}, collect_entities);
 
-    return position;
+    return glm::vec3{hit.x, position.y, hit.y};
 }
 
 std::optional<glm::vec3>
-world_t::raycast_entities(std::set<entity_t*>& entities, glm::vec3 position, glm::vec3 direction, uint64_t collision_mask, entity_t** hit_entity)
+world_t::raycast_entities(const std::vector<entity_t*>& entities, glm::vec3 position, glm::vec3 direction, uint64_t collision_mask, entity_t** hit_entity)
 {
     std::optional<glm::vec3> nearest_point;
 
@@ -534,20 +745,53 @@ world_t::raycast_entities(std::set<entity_t*>& entities, glm::vec3 position, glm
     return nearest_point;
 }
 
+glm::vec3 world_t::navigation_direction(glm::vec3 position) const
+{
+    const glm::ivec2 tile_position = glm::floor(glm::vec2{position.x, position.z});
+    const glm::ivec2 next_tile     = navigation_m.next_cell(tile_position);
+
+    if(next_tile == tile_position)
+        return {};
+
+    // Head for the center of the next tile, so corners get rounded rather than scraped along.
+    const glm::vec2 direction = glm::vec2{next_tile} + 0.5f - glm::vec2{position.x, position.z};
+    return glm::normalize(glm::vec3{direction.x, 0.0f, direction.y});
+}
+
+bool world_t::entity_visible(const entity_t& entity) const
+{
+    return entity.visible_frame() == visibility_query_m.frame();
+}
+
 player_t* world_t::player()
 {
     return player_m;
 }
 
+uint32_t world_t::next_random_seed()
+{
+    return static_cast<uint32_t>(random_m());
+}
+
 void world_t::play_sound(audio_clip_handle_t clip)
 {
-    if (clip)
+    if(!clip)
+        return;
+
+    if(world_commands_t* commands = recording_world_commands())
+        commands->sounds.push_back({clip, std::nullopt});
+    else
         engine_m.audio().play_clip(clip);
 }
 
 void world_t::play_sound_at(audio_clip_handle_t clip, glm::vec3 position)
 {
-    if(clip)
+    if(!clip)
+        return;
+
+    if(world_commands_t* commands = recording_world_commands())
+        commands->sounds.push_back({clip, position});
+    else
         engine_m.audio().play_clip(clip, position);
 }
 
@@ -566,6 +810,62 @@ const std::map<particle_type_t, particle_descriptor_t>& world_t::particle_descri
     return particle_descriptors_m;
 }
 
+void world_t::parallel_for_deferred(size_t count, size_t grain, const job_system_t::range_function_t& function)
+{
+    range_commands_m.parallel_for(engine_m.jobs(), count, grain, tick_commands_m, function);
+}
+
+void world_t::apply_commands()
+{
+    MAU_PROFILE_ZONE("apply_commands");
+
+    for(auto& entity: tick_commands_m.entities)
+        entities_m.push_back(entity_handle_t{entity.release()});
+
+    // Projectiles add their lights while being constructed, so spawn them ahead of the rest of the lights.
+    for(const auto& projectile: tick_commands_m.projectiles)
+        spawn_projectile(projectile.position, projectile.orientation, projectile.owner, projectile.type);
+
+    for(const auto& light: tick_commands_m.lights)
+        dynamic_lights_m.push_back(dynamic_light_pool_m.create(light));
+
+    for(const auto& particle: tick_commands_m.particles)
+        particle_system_m.emit(particle.position, particle_descriptors_m.at(particle.type));
+
+    for(const auto& sound: tick_commands_m.sounds)
+    {
+        if(sound.position)
+            engine_m.audio().play_clip(sound.clip, *sound.position);
+        else
+            engine_m.audio().play_clip(sound.clip);
+    }
+
+    for(const auto& query: tick_commands_m.line_of_sight_queries)
+        query_line_of_sight(query.position, query.direction, query.collision_mask, query.ignore_entity, query.query);
+
+    tick_commands_m.clear();
+}
+
+void world_t::remove_destroyed_entities()
+{
+    destroyed_entities_m.clear();
+    for(auto& entity: entities_m)
+    {
+        if(entity->destroyed())
+            destroyed_entities_m.push_back(entity.get());
+    }
+
+    if(destroyed_entities_m.empty())
+        return;
+
+    world_info_m.remove_destroyed_entities(destroyed_entities_m);
+
+    entities_m.erase(std::remove_if(entities_m.begin(),
+                                    entities_m.end(),
+                                    [](const entity_handle_t& entity) { return entity->destroyed(); }),
+                     entities_m.end());
+}
+
 glm::ivec2 world_t::chunk_position(glm::ivec2 tile_position)
 {
     glm::ivec2 chunk_position;
@@ -60,10 +60,9 @@ inline static constexpr std::array<std::array<int32_t, 6>, 6> side_vertex_indice
 
 std::array<int32_t, 6> vertex_uv_indices = {0, 2, 1, 2, 3, 1};
 
-chunk_t::chunk_t(world_t& world, glm::ivec2 position) : world_m(world), position_m(position)
+chunk_t::chunk_t(world_t& world, glm::ivec2 position, std::vector<vertex_t>& vertex_data) :
+    world_m(world), position_m(position), first_m(static_cast<int32_t>(vertex_data.size()))
 {
-    std::vector<vertex_t> vertex_data;
-
     for(auto y = position_m.y; y < position_m.y + chunk_size_k; ++y)
     {
         for(auto x = position_m.x; x < position_m.x + chunk_size_k; ++x)
@@ -143,12 +142,23 @@ chunk_t::chunk_t(world_t& world, glm::ivec2 position) : world_m(world), position
         }
     }
 
-    vertex_object_m = vertex_object_t::create(vertex_primitive_t::triangle_k, vertex_object_mode_t::static_k, vertex_data);
+    count_m = static_cast<int32_t>(vertex_data.size()) - first_m;
+}
+
+glm::vec3 chunk_t::center() const
+{
+    const glm::vec2 center = glm::vec2{position_m} + chunk_size_k / 2.0f;
+    return glm::vec3{center.x, 0.0f, center.y};
+}
+
+int32_t chunk_t::first() const
+{
+    return first_m;
 }
 
-vertex_object_handle_t chunk_t::vertex_object() const
+int32_t chunk_t::count() const
 {
-    return vertex_object_m;
+    return count_m;
 }
 
 } // namespace mau
@@ -0,0 +1,74 @@
+#include "worship/gameplay/world/world_commands.hpp"
+
+namespace mau {
+
+static thread_local world_commands_t* recording_commands = nullptr;
+
+template<typename T>
+static void append_moved(std::vector<T>& to, std::vector<T>& from)
+{
+    to.insert(to.end(), std::make_move_iterator(from.begin()), std::make_move_iterator(from.end()));
+}
+void world_commands_t::append(world_commands_t& commands)
+{
+    append_moved(entities, commands.entities);
+    append_moved(projectiles, commands.projectiles);
+    append_moved(particles, commands.particles);
+    append_moved(sounds, commands.sounds);
+    append_moved(lights, commands.lights);
+    append_moved(line_of_sight_queries, commands.line_of_sight_queries);
+
+    commands.clear();
+}
+void world_commands_t::clear()
+{
+    entities.clear();
+    projectiles.clear();
+    particles.clear();
+    sounds.clear();
+    lights.clear();
+    line_of_sight_queries.clear();
+}
+world_commands_t* recording_world_commands()
+{
+    return recording_commands;
+}
+world_commands_scope_t::world_commands_scope_t(world_commands_t* commands) : previous_m(recording_commands)
+{
+    recording_commands = commands;
+}
+world_commands_scope_t::~world_commands_scope_t()
+{
+    recording_commands = previous_m;
+}
+void range_world_commands_t::parallel_for(job_system_t&                         jobs,
+                                          size_t                                count,
+                                          size_t                                grain,
+                                          world_commands_t&                     commands,
+                                          const job_system_t::range_function_t& function)
+{
+    const size_t range_count = (count + grain - 1) / grain;
+    if(buffers_m.size() < range_count)
+        buffers_m.resize(range_count);
+
+    try
+    {
+        jobs.parallel_for(count, grain, [this, grain, &function](size_t begin, size_t end) {
+            world_commands_scope_t scope{&buffers_m[begin / grain]};
+            function(begin, end);
+        });
+    }
+    catch(...)
+    {
+        // Ranges which finished have recorded their share, which would otherwise show up with the next loop.
+        for(size_t range = 0; range < range_count; ++range)
+            buffers_m[range].clear();
+
+        throw;
+    }
+
+    for(size_t range = 0; range < range_count; ++range)
+        commands.append(buffers_m[range]);
+}
+
+} // namespace mau
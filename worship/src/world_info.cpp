@@ -4,6 +4,7 @@
 
 #include <mau/io/file_reader.hpp>
 
+#include <algorithm>
 #include <queue>
 #include <set>
 
@@ -88,7 +89,7 @@ void world_info_t::add_entity(entity_t* entity)
             if(!current_tile)
                 continue;
 
-            current_tile->entities.insert(entity);
+            current_tile->entities.push_back(entity);
         }
     }
 }
@@ -105,11 +106,48 @@ void world_info_t::remove_entity(entity_t* entity)
             if(!current_tile)
                 continue;
 
-            current_tile->entities.erase(entity);
+            auto& entities = current_tile->entities;
+            auto  it       = std::find(entities.begin(), entities.end(), entity);
+            if(it != entities.end())
+            {
+                *it = entities.back();
+                entities.pop_back();
+            }
         }
     }
 }
 
+void world_info_t::remove_destroyed_entities(const std::vector<entity_t*>& entities)
+{
+    swept_tiles_m.clear();
+
+    for(entity_t* entity: entities)
+    {
+        glm::ivec2 position{entity->position().x, entity->position().z};
+
+        for(int32_t x = position.x - entity_spatial_range_k; x <= position.x + entity_spatial_range_k; ++x)
+        {
+            for(int32_t y = position.y - entity_spatial_range_k; y <= position.y + entity_spatial_range_k; ++y)
+            {
+                if(x >= 0 && y >= 0 && x < size_m.x && y < size_m.y)
+                    swept_tiles_m.push_back(y * size_m.x + x);
+            }
+        }
+    }
+
+    std::sort(swept_tiles_m.begin(), swept_tiles_m.end());
+    swept_tiles_m.erase(std::unique(swept_tiles_m.begin(), swept_tiles_m.end()), swept_tiles_m.end());
+
+    for(size_t index: swept_tiles_m)
+    {
+        auto& tile_entities = tile_info_m[index].entities;
+        tile_entities.erase(std::remove_if(tile_entities.begin(),
+                                           tile_entities.end(),
+                                           [](entity_t* entity) { return entity->destroyed(); }),
+                            tile_entities.end());
+    }
+}
+
 glm::ivec2 world_info_t::size() const
 {
     return size_m;